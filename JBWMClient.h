@@ -6,20 +6,35 @@
 #define JBWM_CLIENT_STRUCT_H
 #include <X11/Xlib.h>
 #include "JBWMClientOptions.h"
+#include "JBWMClientSizeHints.h"
 #include "JBWMClientTitleBar.h"
+#include "JBWMClientTransaction.h"
 #include "JBWMRectangle.h"
 #include "JBWMScreen.h"
 struct JBWMScreen;
 /* Sizes given for x86_64 architecture. */
 struct JBWMClient {
-  struct JBWMClientTitleBar tb; /* 40 bytes */
+  struct JBWMClientTitleBar tb; /* 8 bytes */
   union JBWMRectangle size, old_size, before_fullscreen;
+  /* Geometry last sent to the server by jbwm_move_resize.  A width of 0
+   * marks it invalid, forcing the next commit to send everything.  */
+  union JBWMRectangle committed;
+  // Bounding shape extents of the client window, if shaped.
+  union JBWMRectangle shape;
   Colormap cmap;
   Window window, parent;
+  char * title; // WM_NAME, as last read, or NULL
   struct JBWMClient * next;
+  /* Links within the screen's desktop bucket or sticky list.  prev points
+   * at whichever pointer points at this client.  */
+  struct JBWMClient * desktop_next, ** desktop_prev;
+  // Links within the most recently focused list of its desktop.
+  struct JBWMClient * focus_next, ** focus_prev;
   struct JBWMScreen * screen;
-  struct JBWMClientOptions opt; /* 2 bytes */
-  uint8_t vdesk;
+  struct JBWMClientSizeHints hints;
+  struct JBWMClientOptions opt; /* 3 bytes */
+  struct JBWMClientTransaction transaction; /* 6 bytes */
+  uint8_t vdesk, committed_offset;
   int8_t ignore_unmap;
 };
 #endif /* JBWM_CLIENT_STRUCT_H */
@@ -18,6 +18,7 @@ struct JBWMClientOptions {
   bool shaded : 1;
   bool shaped : 1;
   bool sticky : 1;
+  bool suspended : 1; // covered in fullscreen mode
   bool tearoff : 1;
 };
 #endif//!JBWM_JBWMCLIENTOPTIONS_H
@@ -0,0 +1,13 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_JBWMCLIENTSIZEHINTS_H
+#define JBWM_JBWMCLIENTSIZEHINTS_H
+#include "JBWMSize.h"
+#include <stdbool.h>
+/* WM_NORMAL_HINTS as applied to resizing.  Read when first needed, and
+ * again after the property changes.  A zero maximum or aspect is unset,
+ * and increments are at least 1.  Aspects are width over height.  */
+struct JBWMClientSizeHints {
+  struct JBWMSize min, max, base, increment, min_aspect, max_aspect;
+  bool loaded;
+};
+#endif//!JBWM_JBWMCLIENTSIZEHINTS_H
@@ -2,7 +2,8 @@
 #ifndef JBWM_JBWMCLIENTTITLEBAR_H
 #define JBWM_JBWMCLIENTTITLEBAR_H
 #include <X11/X.h>
+// The buttons are drawn into win rather than being windows of their own.
 struct JBWMClientTitleBar {
-  Window win, close, resize, shade, stick;
+  Window win;
 };
 #endif//!JBWM_JBWMCLIENTTITLEBAR_H
@@ -0,0 +1,14 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_JBWMCLIENTTRANSACTION_H
+#define JBWM_JBWMCLIENTTRANSACTION_H
+#include <stdbool.h>
+#include <stdint.h>
+/* Changes accumulated between jbwm_begin and jbwm_commit.  The state
+ * masks hold one bit per atom, counting from _NET_WM_STATE_STICKY.  */
+struct JBWMClientTransaction {
+  uint16_t state_add, state_remove;
+  uint8_t depth;
+  bool geometry : 1;
+  bool title : 1;
+};
+#endif//!JBWM_JBWMCLIENTTRANSACTION_H
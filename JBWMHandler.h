@@ -0,0 +1,24 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_JBWMHANDLER_H
+#define JBWM_JBWMHANDLER_H
+// Which handler the event loop ran for an event, as traced.
+enum JBWMHandler {
+  JBWM_HANDLER_NONE, // the event was ignored
+  JBWM_HANDLER_CONFIGURE_NOTIFY,
+  JBWM_HANDLER_CONFIGURE_REQUEST,
+  JBWM_HANDLER_KEY_EVENT,
+  JBWM_HANDLER_KEY_RELEASE,
+  JBWM_HANDLER_BUTTON_EVENT,
+  JBWM_HANDLER_ENTER_NOTIFY,
+  JBWM_HANDLER_EXPOSE,
+  JBWM_HANDLER_CLIENT_LIST, // marked stale
+  JBWM_HANDLER_CLIENT_FREE,
+  JBWM_HANDLER_MAP_REQUEST,
+  JBWM_HANDLER_PROPERTY_NOTIFY,
+  JBWM_HANDLER_COLORMAP_NOTIFY,
+  JBWM_HANDLER_CLIENT_MESSAGE,
+  JBWM_HANDLER_MAPPING_NOTIFY,
+  JBWM_HANDLER_SHAPE_NOTIFY,
+  JBWM_HANDLER_MONITOR_EVENT
+};
+#endif//!JBWM_JBWMHANDLER_H
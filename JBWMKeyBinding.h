@@ -0,0 +1,13 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_JBWMKEYBINDING_H
+#define JBWM_JBWMKEYBINDING_H
+#include <X11/X.h>
+#include <stdbool.h>
+struct JBWMKeyContext;
+struct JBWMKeyBinding {
+  KeySym key;
+  void (*action)(struct JBWMKeyContext * k);
+  // Needs a current client, and is refused while it is fullscreen.
+  bool client;
+};
+#endif//!JBWM_JBWMKEYBINDING_H
@@ -0,0 +1,10 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_JBWMPLACEMENT_H
+#define JBWM_JBWMPLACEMENT_H
+// How windows which do not position themselves are placed, chosen by -p.
+enum JBWMPlacement {
+  JBWM_PLACE_SMART, // where they overlap other windows least
+  JBWM_PLACE_CASCADE,
+  JBWM_PLACE_CENTER
+};
+#endif//!JBWM_JBWMPLACEMENT_H
@@ -0,0 +1,13 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_JBWMPROPERTY_H
+#define JBWM_JBWMPROPERTY_H
+#include <X11/Xlib.h>
+#include <stdint.h>
+// A window property to be read by the worker, or read by it.
+struct JBWMProperty {
+  Window window;
+  Atom atom;
+  void * value; // free with XFree if not NULL
+  uint16_t count;
+};
+#endif//!JBWM_JBWMPROPERTY_H
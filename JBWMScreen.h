@@ -5,6 +5,7 @@
 #ifndef JBWM_JBWMSCREEN_H
 #define JBWM_JBWMSCREEN_H
 #include "JBWMPixels.h"
+#include "JBWMRectangle.h"
 #include <X11/Xlib.h>
 #ifdef JBWM_USE_XFT
 #include <X11/Xft/Xft.h>
@@ -19,8 +20,22 @@ struct JBWMScreen {
   XFontStruct *font;
 #endif//JBWM_USE_XFT
   Window supporting;
+  Window osd; // desktop indicator, created on first use
+  Window outline; // drawn while dragging, created on first use
+  /* Clients of each virtual desktop, indexed by vdesk, and the sticky
+   * clients, which are on all of them.  */
+  struct JBWMClient * desktops[UINT8_MAX + 1], * sticky;
+  /* Clients of each virtual desktop, most recently focused first.
+   * Sticky clients are kept in that of the current desktop.  */
+  struct JBWMClient * focus[UINT8_MAX + 1];
+  /* Monitor geometry, loaded at startup and on RRScreenChangeNotify, so
+   * nothing else needs to query it.  */
+  union JBWMRectangle * monitors;
+  /* The fullscreen client focused on the desktop shown, if any, while
+   * the screen is in fullscreen mode.  */
+  struct JBWMClient * fullscreen;
   struct JBWMPixels pixels;
-  GC gc,border_gc;
-  uint8_t id, vdesk, font_height;
+  GC gc;
+  uint8_t id, vdesk, font_height, monitor_count;
 };
 #endif//!JBWM_JBWMSCREEN_H
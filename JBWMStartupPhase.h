@@ -0,0 +1,15 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_JBWMSTARTUPPHASE_H
+#define JBWM_JBWMSTARTUPPHASE_H
+// Startup phases timed for -T, in the order they begin.
+enum JBWMStartupPhase {
+  JBWM_PHASE_DISPLAY,
+  JBWM_PHASE_ATOMS,
+  JBWM_PHASE_FONT,
+  JBWM_PHASE_COLORS,
+  JBWM_PHASE_GRABS,
+  JBWM_PHASE_ADOPTION,
+  JBWM_PHASE_EWMH,
+  JBWM_PHASE_COUNT
+};
+#endif//!JBWM_JBWMSTARTUPPHASE_H
@@ -0,0 +1,28 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_JBWMSTATEENTRY_H
+#define JBWM_JBWMSTATEENTRY_H
+#include <stdint.h>
+enum {
+  JBWM_STATE_TITLE_SIZE = 68, // NUL terminated, cut short if longer
+  // Bits of struct JBWMStateEntry.flags:
+  JBWM_STATE_FOCUSED = 1,
+  JBWM_STATE_STICKY = 2,
+  JBWM_STATE_SHADED = 4,
+  JBWM_STATE_FULLSCREEN = 8,
+  JBWM_STATE_MAX_HORZ = 16,
+  JBWM_STATE_MAX_VERT = 32,
+  JBWM_STATE_NO_TITLE_BAR = 64,
+  JBWM_STATE_HIDDEN = 128 // on a desktop not shown
+};
+/* One managed client in the shared state.  The geometry is that of the
+ * frame, title bar included and border excluded.  generation is that of
+ * the header when the entry last changed.  stacking counts up from the
+ * bottom of the client's screen.  */
+struct JBWMStateEntry {
+  uint32_t generation, window, frame;
+  int16_t x, y, width, height;
+  uint16_t stacking, flags;
+  uint8_t screen, desktop;
+  char title[JBWM_STATE_TITLE_SIZE];
+};
+#endif//!JBWM_JBWMSTATEENTRY_H
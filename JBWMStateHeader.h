@@ -0,0 +1,21 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_JBWMSTATEHEADER_H
+#define JBWM_JBWMSTATEHEADER_H
+#include <stdint.h>
+enum {
+  JBWM_STATE_MAGIC = 0x4a42574d, // "JBWM"
+  JBWM_STATE_VERSION = 1,
+  JBWM_STATE_SCREENS = 16
+};
+/* The shared state starts with this header, and capacity entries of
+ * entry_size bytes follow it, count of them in use.  sequence is odd
+ * while jbwm writes.  To read, load sequence, retry while it is odd, copy
+ * what is needed, then retry if sequence has changed.  generation counts
+ * changes published.  */
+struct JBWMStateHeader {
+  uint32_t magic, version, sequence, generation;
+  uint32_t header_size, entry_size, capacity, count;
+  uint32_t active; // focused window, or 0
+  uint8_t screen_count, desktop[JBWM_STATE_SCREENS]; // shown desktops
+};
+#endif//!JBWM_JBWMSTATEHEADER_H
@@ -0,0 +1,12 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_JBWMTITLEBARBUTTON_H
+#define JBWM_JBWMTITLEBARBUTTON_H
+// Buttons drawn into the title bar, JBWM_BUTTON_NONE if none is hit.
+enum JBWMTitleBarButton {
+  JBWM_BUTTON_CLOSE,
+  JBWM_BUTTON_RESIZE,
+  JBWM_BUTTON_SHADE,
+  JBWM_BUTTON_STICK,
+  JBWM_BUTTON_NONE
+};
+#endif//!JBWM_JBWMTITLEBARBUTTON_H
@@ -12,23 +12,27 @@
 static void handle_title_bar_button(XButtonEvent * e, struct JBWMClient * c,
   struct JBWMClient ** head_client, struct JBWMClient ** current_client)
 {
-  JBWM_LOG("e->window: %d, c->title_bar: %d, e->subwindow: %d",
-    (int)e->window, (int)c->tb.win, (int)e->subwindow);
-  JBWM_LOG("c->tb.close: %d", (int)c->tb.close);
+  JBWM_LOG("e->window: %d, c->title_bar: %d, e->x: %d",
+    (int)e->window, (int)c->tb.win, (int)e->x);
   JBWM_LOG("e->button: %d", (int)e->button);
-  struct JBWMClientOptions * o = &c->opt;
-  if (!e->subwindow)
-    jbwm_drag(c, head_client, false);
-  else if (e->subwindow == c->tb.close && !o->no_close)
+  // Presses elsewhere on the frame, or with the modifier held, drag.
+  switch (e->window == c->tb.win ? jbwm_get_title_bar_button(c, e->x)
+    : JBWM_BUTTON_NONE) {
+  case JBWM_BUTTON_CLOSE:
     jbwm_send_wm_delete(c);
-  else if (e->subwindow == c->tb.resize && !o->no_resize)
-    jbwm_drag(c, head_client, !c->opt.no_resize);
-  else if (e->subwindow == c->tb.shade && !o->no_shade)
+    break;
+  case JBWM_BUTTON_RESIZE:
+    jbwm_drag(c, head_client, true);
+    break;
+  case JBWM_BUTTON_SHADE:
     jbwm_toggle_shade(c);
-  else if (e->subwindow == c->tb.stick)
+    break;
+  case JBWM_BUTTON_STICK:
     jbwm_toggle_sticky(c, current_client);
-  else
+    break;
+  default:
     jbwm_drag(c, head_client, false);
+  }
 }
 void jbwm_handle_button_event(XButtonEvent * e, struct JBWMClient * c,
   struct JBWMClient ** head_client,
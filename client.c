@@ -7,6 +7,7 @@
 #include "ewmh.h"
 #include "ewmh_state.h"
 #include "atom.h"
+#include "max.h"
 #include "select.h"
 #include "title_bar.h"
 #include "util.h"
@@ -28,6 +29,28 @@ static void relink(const struct JBWMClient * c, struct JBWMClient * i,
     relink(c, (i->next != c) ? i->next : (i->next = c->next),
       head_client, current_client);
 }
+static void unlink_desktop(struct JBWMClient * c)
+{
+  if (c->desktop_prev) {
+    if ((*c->desktop_prev = c->desktop_next))
+      c->desktop_next->desktop_prev = c->desktop_prev;
+    c->desktop_prev = NULL;
+  }
+}
+/* Move c into the bucket of its desktop, or the sticky list, and to the
+ * front of its desktop's focus list, in O(1).  */
+void jbwm_link_client(struct JBWMClient * c)
+{
+  struct JBWMScreen * s = c->screen;
+  struct JBWMClient ** head = c->opt.sticky ? &s->sticky
+    : &s->desktops[c->vdesk];
+  unlink_desktop(c);
+  if ((c->desktop_next = *head))
+    c->desktop_next->desktop_prev = &c->desktop_next;
+  *head = c;
+  c->desktop_prev = head;
+  jbwm_link_focus(c);
+}
 void jbwm_set_client_vdesk(struct JBWMClient * c, uint8_t desktop)
 {
   Display *d;
@@ -37,8 +60,12 @@ void jbwm_set_client_vdesk(struct JBWMClient * c, uint8_t desktop)
     /*  Save in an atomic property, useful for restart and deskbars. */
     XChangeProperty(d, c->window, jbwm_atoms[JBWM_NET_WM_DESKTOP],
       XA_CARDINAL, 8, PropModeReplace, (unsigned char *)&desktop, 1);
-    if(c->screen->vdesk!=c->vdesk)
-      jbwm_hide_client(c);
+    if (!c->opt.sticky) { // sticky clients stay on every desktop
+      jbwm_link_client(c);
+      if(c->screen->vdesk!=c->vdesk)
+        jbwm_hide_client(c);
+      jbwm_update_fullscreen_mode(c->screen);
+    }
   }
 }
 /* Return the client that has specified window as either window or parent.
@@ -51,11 +78,17 @@ struct JBWMClient * jbwm_find_client(
     && head->tb.win != w) ? jbwm_find_client(head->next, w) : head;
 
 }
+void jbwm_set_sticky(struct JBWMClient * c, const bool sticky)
+{
+  c->opt.sticky = sticky;
+  // Sticky clients follow the current desktop, so unsticking leaves c there.
+  jbwm_link_client(c);
+}
 void jbwm_toggle_sticky(struct JBWMClient * c,
   struct JBWMClient ** current_client)
 {
   if(c){
-    c->opt.sticky ^= true; /*  toggle */
+    jbwm_set_sticky(c, !c->opt.sticky);
     jbwm_select_client(c, current_client);
     jbwm_update_title_bar(c);
     {
@@ -83,6 +116,11 @@ void jbwm_client_free(struct JBWMClient * c, struct JBWMClient ** head_client,
   if(parent)
     XDestroyWindow(d, parent);
   relink(c, *head_client, head_client, current_client);
+  unlink_desktop(c);
+  jbwm_unlink_focus(c);
+  jbwm_update_fullscreen_mode(c->screen);
+  if (c->title)
+    XFree(c->title);
   free(c);
 }
 void jbwm_hide_client(const struct JBWMClient * c)
@@ -4,6 +4,7 @@
 /* See README for license and other details. */
 #ifndef JBWM_CLIENT_H
 #define JBWM_CLIENT_H
+#include <stdbool.h>
 #include <stdint.h>
 #include <X11/Xlib.h>
 struct JBWMClient;
@@ -13,8 +14,13 @@ void jbwm_client_free(struct JBWMClient * c,
   struct JBWMClient ** current_client);
 /* Get the client with input focus. */
 void jbwm_hide_client(const struct JBWMClient * c);
+/* Add c to its screen's desktop bucket, or the sticky list if sticky.
+ * This is also used to move c between them.  */
+void jbwm_link_client(struct JBWMClient * c);
 /* Move the client to the specified virtual desktop */
 void jbwm_set_client_vdesk(struct JBWMClient * c, uint8_t desktop);
+/* Set stickiness without the focus and title bar updates of toggling */
+void jbwm_set_sticky(struct JBWMClient * c, const bool sticky);
 void jbwm_toggle_sticky(struct JBWMClient * c,
   struct JBWMClient ** current_client);
 void jbwm_restore_client(struct JBWMClient const * c);
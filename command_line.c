@@ -7,22 +7,74 @@
 #include "config.h"
 #include "log.h"
 //
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 //
+static bool warp = true, startup_timing, export_state,
+  control;
+static enum JBWMPlacement placement;
+bool jbwm_get_warp(void)
+{
+  return warp;
+}
+bool jbwm_get_startup_timing(void)
+{
+  return startup_timing;
+}
+bool jbwm_get_export(void)
+{
+  return export_state;
+}
+bool jbwm_get_control(void)
+{
+  return control;
+}
+enum JBWMPlacement jbwm_get_placement(void)
+{
+  return placement;
+}
+// Return false if name is no placement.
+static bool set_placement(const char * name)
+{
+  static const char * const names[] = {"smart", "cascade", "center"};
+  uint8_t i;
+  for (i = 0; i < sizeof(names) / sizeof(*names); ++i)
+    if (!strcmp(name, names[i])) {
+      placement = i;
+      return true;
+    }
+  return false;
+}
 void jbwm_parse_command_line(const int argc, char **argv)
 {
   JBWM_LOG("parse_argv(%d,%s...)", argc, argv[0]);
-  static const char optstring[] = "1:2:v";
+  static const char optstring[] = "1:2:cp:sTvw";
   int8_t opt;
   while((opt = getopt(argc, argv, optstring)) != -1)
     switch (opt) {
+    case 'c':
+      control = true;
+      break;
+    case 's':
+      export_state = true;
+      break;
+    case 'T':
+      startup_timing = true;
+      break;
     case 'v':
       printf("%s version %s\n", argv[0], VERSION);
       exit(0);
+    case 'w':
+      warp = false;
+      break;
+    case 'p':
+      if (set_placement(optarg))
+        break;
+      // FALLTHROUGH
     default:
       printf("%s -[%s]\n", argv[0], optstring);
       exit(1);
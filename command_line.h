@@ -4,5 +4,17 @@
 // See README for license and other details.
 #ifndef JBWM_COMMAND_LINE_H
 #define JBWM_COMMAND_LINE_H
+#include "JBWMPlacement.h"
+#include <stdbool.h>
 void jbwm_parse_command_line(const int argc, char **argv);
+// Whether keyboard focus changes may warp the pointer, unset by -w.
+bool jbwm_get_warp(void) __attribute__((pure));
+// Whether to report how long each startup phase took, set by -T.
+bool jbwm_get_startup_timing(void) __attribute__((pure));
+// Whether to publish the clients in shared memory, set by -s.
+bool jbwm_get_export(void) __attribute__((pure));
+// Whether to accept commands on a local socket, set by -c.
+bool jbwm_get_control(void) __attribute__((pure));
+// How to place windows that do not position themselves, set by -p.
+enum JBWMPlacement jbwm_get_placement(void) __attribute__((pure));
 #endif//!JBWM_COMMAND_LINE_H
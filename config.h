@@ -16,9 +16,11 @@
 /* Default colors */
 #ifndef USE_OLD_THEME
 //#define JBWM_FG "#bbf"
-#define JBWM_FG "white"
-#define JBWM_FC "green1"
-#define JBWM_BG "black"
+/* Hexadecimal colors are resolved without asking the server on TrueColor
+ * displays, so prefer them to names.  */
+#define JBWM_FG "#ffffff"
+#define JBWM_FC "#00ff00"
+#define JBWM_BG "#000000"
 #define JBWM_CLOSE "#a77"
 #define JBWM_RESIZE "#aaa"
 #define JBWM_SHADE "#77a"
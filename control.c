@@ -0,0 +1,236 @@
+// Copyright 2020, Alisa Bedard
+#include "control.h"
+#include "JBWMClient.h"
+#include "JBWMScreen.h"
+#include "client.h"
+#include "command_line.h"
+#include "config.h"
+#include "crossing.h"
+#include "log.h"
+#include "macros.h"
+#include "max.h"
+#include "move_resize.h"
+#include "select.h"
+#include "transaction.h"
+#include "vdesk.h"
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+enum { CONTROL_MESSAGE_SIZE = 65536 };
+static int control_fd = -1;
+static struct sockaddr_un control_address;
+/* The state of the batch being applied.  Each client touched is begun
+ * once and committed at the end, so the batch reaches the server as one
+ * set of requests.  Clients are kept by window, as an error handled in a
+ * round trip within the batch may free them.  */
+struct Batch {
+  struct JBWMScreen * screen;
+  struct JBWMClient ** head_client, ** current_client;
+  Window * begun;
+  size_t begun_count;
+  char * reply;
+  size_t reply_length;
+};
+static void unlink_socket(void)
+{
+  unlink(control_address.sun_path);
+}
+void jbwm_set_up_control(Display * d)
+{
+  const char * dir = getenv("XDG_RUNTIME_DIR");
+  struct sockaddr_un * a = &control_address;
+  char * p;
+  mode_t mask;
+  int error;
+  if (!jbwm_get_control())
+    return;
+  a->sun_family = AF_UNIX;
+  if (dir)
+    snprintf(a->sun_path, sizeof(a->sun_path), "%s/jbwm-%s", dir,
+      DisplayString(d));
+  else
+    snprintf(a->sun_path, sizeof(a->sun_path), "/tmp/jbwm-%d-%s",
+      (int)getuid(), DisplayString(d));
+  // Only the file name comes from the display.
+  for (p = strrchr(a->sun_path, '/') + 1; *p; ++p)
+    if (*p == '/')
+      *p = '_';
+  control_fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+  if (control_fd < 0)
+    return;
+  fcntl(control_fd, F_SETFD, FD_CLOEXEC);
+  fcntl(control_fd, F_SETFL, O_NONBLOCK);
+  // Left behind by a jbwm which did not exit, or by a restart.
+  unlink(a->sun_path);
+  // Created private, so no other user can connect before the chmod.
+  mask = umask(077);
+  error = bind(control_fd, (struct sockaddr *)a, sizeof(*a));
+  umask(mask);
+  if (error || chmod(a->sun_path, 0600)) {
+    JBWM_LOG("Cannot listen on %s", a->sun_path);
+    close(control_fd);
+    control_fd = -1;
+    return;
+  }
+  atexit(unlink_socket);
+}
+int jbwm_get_control_fd(void)
+{
+  return control_fd;
+}
+__attribute__((format(printf, 2, 3)))
+static void reply(struct Batch * b, const char * format, ...)
+{
+  va_list v;
+  int n;
+  va_start(v, format);
+  n = vsnprintf(b->reply + b->reply_length,
+    CONTROL_MESSAGE_SIZE - b->reply_length, format, v);
+  va_end(v);
+  if (n > 0) // Cut short rather than overflow.
+    b->reply_length = JB_MIN(b->reply_length + n,
+      CONTROL_MESSAGE_SIZE - 1);
+}
+static void query(struct Batch * b)
+{
+  struct JBWMClient * c;
+  const uint8_t n = ScreenCount(b->screen->xlib->display);
+  uint8_t i;
+  for (i = 0; i < n; ++i)
+    reply(b, "screen %d desktop %d\n", i, b->screen[i].vdesk);
+  for (c = *b->head_client; c; c = c->next)
+    reply(b, "0x%lx %d %d %d %d %d %d %d %s\n", c->window, c->size.x,
+      c->size.y, c->size.width, c->size.height, c->screen->id, c->vdesk,
+      c == *b->current_client, c->title ? c->title : "");
+}
+// Return the client with window id, begun within the batch once.
+static struct JBWMClient * get_client(struct Batch * b, const char * id)
+{
+  const Window w = strtoul(id, NULL, 0);
+  struct JBWMClient * c;
+  Window * p;
+  size_t i;
+  if (!w || !(c = jbwm_find_client(*b->head_client, w)))
+    return NULL;
+  for (i = 0; i < b->begun_count; ++i)
+    if (b->begun[i] == c->window)
+      return c;
+  p = realloc(b->begun, (b->begun_count + 1) * sizeof(*p));
+  if (!p)
+    return NULL;
+  b->begun = p;
+  b->begun[b->begun_count++] = c->window;
+  jbwm_begin(c);
+  return c;
+}
+static bool set_desktop(struct Batch * b, const int v)
+{
+  struct JBWMClient * c = *b->current_client;
+  if (v < 0 || v >= JBWM_NUMBER_OF_DESKTOPS)
+    return false;
+  jbwm_set_vdesk(c ? c->screen : b->screen, b->current_client, v);
+  return true;
+}
+static bool send_to_desktop(struct JBWMClient * c, const int v)
+{
+  if (v < 0 || v >= JBWM_NUMBER_OF_DESKTOPS)
+    return false;
+  jbwm_set_client_vdesk(c, v);
+  if (c->vdesk == c->screen->vdesk)
+    jbwm_restore_client(c);
+  return true;
+}
+static void focus(struct Batch * b, struct JBWMClient * c)
+{
+  if (!c->opt.sticky && c->vdesk != c->screen->vdesk)
+    jbwm_set_vdesk(c->screen, b->current_client, c->vdesk);
+  jbwm_select_client(c, b->current_client);
+}
+// Run one command, returning false if it is not understood.
+static bool run(struct Batch * b, const char * line)
+{
+  char verb[16], id[32];
+  struct JBWMClient * c;
+  int v[4];
+  if (sscanf(line, "%15s", verb) != 1)
+    return true; // blank
+  if (!strcmp(verb, "query")) {
+    query(b);
+    return true;
+  }
+  if (!strcmp(verb, "desktop"))
+    return sscanf(line, "%*s %d", v) == 1 && set_desktop(b, v[0]);
+  if (sscanf(line, "%*s %31s", id) != 1 || !(c = get_client(b, id)))
+    return false;
+  if (!strcmp(verb, "move")) {
+    if (sscanf(line, "%*s %*s %d %d %d %d", v, v + 1, v + 2, v + 3) != 4
+      || v[2] < 1 || v[3] < 1)
+      return false;
+    c->size = (union JBWMRectangle){.x = v[0], .y = v[1], .width = v[2],
+      .height = v[3]};
+    jbwm_move_resize(c);
+  } else if (!strcmp(verb, "send"))
+    return sscanf(line, "%*s %*s %d", v) == 1 && send_to_desktop(c, v[0]);
+  else if (!strcmp(verb, "maximize")) {
+    jbwm_set_horz(c);
+    jbwm_set_vert(c);
+  } else if (!strcmp(verb, "restore")) {
+    jbwm_set_not_horz(c);
+    jbwm_set_not_vert(c);
+  } else if (!strcmp(verb, "focus"))
+    focus(b, c);
+  else
+    return false;
+  return true;
+}
+static void apply(struct Batch * b, char * message)
+{
+  Display * d = b->screen->xlib->display;
+  char * line, * next;
+  unsigned int i = 0;
+  size_t k;
+  jbwm_begin_ignore_enter(d);
+  for (line = strtok_r(message, "\n;", &next); line;
+    line = strtok_r(NULL, "\n;", &next), ++i)
+    if (!run(b, line))
+      reply(b, "error %u: %s\n", i + 1, line);
+  for (k = 0; k < b->begun_count; ++k) {
+    // Skip clients freed since they were begun.
+    struct JBWMClient * c = jbwm_find_client(*b->head_client, b->begun[k]);
+    if (c)
+      jbwm_commit(c);
+  }
+  free(b->begun);
+  jbwm_end_ignore_enter(d);
+}
+void jbwm_handle_control(struct JBWMScreen * s,
+  struct JBWMClient ** head_client, struct JBWMClient ** current_client)
+{
+  static char message[CONTROL_MESSAGE_SIZE], answer[CONTROL_MESSAGE_SIZE];
+  for (;;) {
+    union {
+      struct sockaddr any;
+      struct sockaddr_un un;
+    } from;
+    socklen_t from_length = sizeof(from);
+    struct Batch b = {.screen = s, .head_client = head_client,
+      .current_client = current_client, .reply = answer};
+    const ssize_t n = recvfrom(control_fd, message, sizeof(message) - 1,
+      0, &from.any, &from_length);
+    if (n < 0)
+      break;
+    message[n] = '\0';
+    apply(&b, message);
+    // Only a sender bound to an address of its own can be answered.
+    if (b.reply_length && from_length > sizeof(sa_family_t))
+      sendto(control_fd, answer, b.reply_length, 0,
+        &from.any, from_length);
+  }
+}
@@ -0,0 +1,18 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_CONTROL_H
+#define JBWM_CONTROL_H
+#include <X11/Xlib.h>
+struct JBWMClient;
+struct JBWMScreen;
+/* With -c, listen for commands on a datagram socket, named
+ * $XDG_RUNTIME_DIR/jbwm-DISPLAY, or /tmp/jbwm-UID-DISPLAY without it.
+ * Each datagram is a batch of commands, one per line, applied together
+ * and sent to the server at once.  */
+void jbwm_set_up_control(Display * d) __attribute__((nonnull));
+// Return the socket to wait on, or -1 without -c.
+int jbwm_get_control_fd(void) __attribute__((pure));
+// Apply every batch waiting on the socket.
+void jbwm_handle_control(struct JBWMScreen * s,
+  struct JBWMClient ** head_client, struct JBWMClient ** current_client)
+__attribute__((nonnull));
+#endif//!JBWM_CONTROL_H
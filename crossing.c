@@ -0,0 +1,24 @@
+// Copyright 2020, Alisa Bedard
+#include "crossing.h"
+#include <stdint.h>
+// Serials of the requests made within the outermost bracket.
+static unsigned long first, last;
+static uint8_t depth;
+void jbwm_begin_ignore_enter(Display * d)
+{
+  if (!depth++)
+    first = NextRequest(d);
+}
+void jbwm_end_ignore_enter(Display * d)
+{
+  if (!--depth && NextRequest(d) != first) {
+    last = NextRequest(d) - 1;
+    /* A crossing caused later by the pointer carries the serial of the
+     * last request processed, so move that past the range.  */
+    XNoOp(d);
+  }
+}
+bool jbwm_is_ignored_enter(XCrossingEvent * e)
+{
+  return e->serial >= first && e->serial <= last;
+}
@@ -0,0 +1,13 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_CROSSING_H
+#define JBWM_CROSSING_H
+#include <X11/Xlib.h>
+#include <stdbool.h>
+/* Raises, warps, maps and desktop switches move windows under a still
+ * pointer.  Bracket such requests with these so the EnterNotify events
+ * they cause, which carry their serials, do not move the focus.  The
+ * brackets may nest.  */
+void jbwm_begin_ignore_enter(Display * d) __attribute__((nonnull));
+void jbwm_end_ignore_enter(Display * d) __attribute__((nonnull));
+bool jbwm_is_ignored_enter(XCrossingEvent * e) __attribute__((nonnull));
+#endif//!JBWM_CROSSING_H
@@ -1,31 +1,48 @@
 atom.o: atom.c atom.h
 button_event.o: button_event.c button_event.h client.h drag.h log.h title_bar.h wm_state.h
-client.o: client.c client.h ewmh.h ewmh_state.h atom.h select.h title_bar.h util.h vdesk.h wm_state.h
+client.o: client.c client.h ewmh.h ewmh_state.h atom.h max.h select.h title_bar.h util.h vdesk.h wm_state.h
 command_line.o: command_line.c command_line.h config.h log.h
-display.o: display.c display.h client.h config.h log.h util.h
-drag.o: drag.c drag.h font.h JBWMClient.h move_resize.h snap.h
+control.o: control.c control.h JBWMClient.h JBWMScreen.h client.h command_line.h config.h crossing.h log.h macros.h max.h move_resize.h select.h transaction.h vdesk.h
+crossing.o: crossing.c crossing.h
+display.o: display.c display.h client.h config.h log.h util.h worker.h
+drag.o: drag.c drag.h font.h JBWMClient.h JBWMScreen.h move_resize.h shape.h size_hints.h snap.h
 draw.o: draw.c draw.h font.h
-events.o: events.c events.h button_event.h client.h ewmh.h ewmh_client.h ewmh_client_list.h JBWMScreen.h key_event.h log.h move_resize.h new.h select.h title_bar.h util.h wm_state.h
+events.o: events.c events.h atom.h button_event.h client.h control.h crossing.h ewmh.h ewmh_client.h ewmh_client_list.h exec.h export.h JBWMScreen.h key_event.h keys.h max.h log.h monitor.h move_resize.h new.h property.h restart.h screen.h select.h shape.h size_hints.h title_bar.h trace.h util.h vdesk.h wake.h wm_state.h worker.h
 ewmh.o: ewmh.c ewmh.h atom.h config.h JBWMClient.h log.h macros.h
-ewmh_client.o: ewmh_client.c ewmh_client.h client.h config.h drag.h ewmh.h ewmh_wm_state.h atom.h select.h util.h vdesk.h wm_state.h
+ewmh_client.o: ewmh_client.c ewmh_client.h client.h config.h drag.h ewmh.h ewmh_wm_state.h atom.h screen.h select.h util.h vdesk.h wm_state.h
 ewmh_client_list.o: ewmh_client_list.c ewmh_client_list.h JBWMClient.h atom.h config.h log.h macros.h
-ewmh_state.o: ewmh_state.c ewmh_state.h client.h drag.h ewmh.h jbwm.h atom.h log.h max.h select.h util.h wm_state.h
-ewmh_wm_state.o: ewmh_wm_state.c ewmh_wm_state.h atom.h JBWMClient.h client.h ewmh.h ewmh_state.h log.h max.h util.h
-exec.o: exec.c exec.h config.h
+ewmh_state.o: ewmh_state.c ewmh_state.h client.h drag.h JBWMClient.h ewmh.h jbwm.h atom.h log.h max.h select.h util.h wm_state.h
+ewmh_wm_state.o: ewmh_wm_state.c ewmh_wm_state.h atom.h JBWMClient.h client.h ewmh.h ewmh_state.h log.h max.h transaction.h util.h
+exec.o: exec.c exec.h log.h wake.h
+export.o: export.c export.h JBWMClient.h JBWMScreen.h JBWMStateEntry.h JBWMStateHeader.h command_line.h log.h macros.h
+fake_x.o: fake_x.c fake_x.h
 font.o: font.c font.h config.h util.h
-geometry.o: geometry.c geometry.h JBWMClient.h JBWMScreen.h JBWMSize.h log.h macros.h
-jbwm.o: jbwm.c jbwm.h config.h ewmh.h font.h atom.h JBWMScreen.h keys.h log.h new.h util.h vdesk.h
-key_event.o: key_event.c key_event.h JBWMClient.h JBWMKeys.h JBWMScreen.h client.h config.h drag.h exec.h log.h max.h move_resize.h select.h snap.h title_bar.h vdesk.h wm_state.h
-keys.o: keys.c keys.h JBWMKeys.h config.h
-main.o: main.c JBWMScreen.h atom.h command_line.h display.h events.h font.h jbwm.h
-max.o: max.c max.h ewmh.h ewmh_state.h font.h atom.h JBWMClient.h move_resize.h title_bar.h
-move_resize.o: move_resize.c move_resize.h JBWMClient.h font.h log.h mwm.h shape.h title_bar.h
+geometry.o: geometry.c geometry.h JBWMClient.h JBWMScreen.h log.h macros.h size_hints.h
+jbwm.o: jbwm.c jbwm.h config.h ewmh.h font.h atom.h client.h JBWMScreen.h keys.h log.h monitor.h new.h screen.h restart.h startup.h util.h vdesk.h
+key_event.o: key_event.c key_event.h JBWMClient.h JBWMKeyBinding.h JBWMKeys.h JBWMScreen.h client.h command_line.h config.h crossing.h drag.h exec.h keys.h log.h max.h move_resize.h restart.h select.h size_hints.h snap.h title_bar.h transaction.h vdesk.h wm_state.h
+keys.o: keys.c keys.h JBWMKeys.h config.h key_event.h
+latency.o: latency.c
+main.o: main.c JBWMScreen.h atom.h command_line.h control.h display.h events.h exec.h export.h font.h jbwm.h keys.h restart.h startup.h trace.h wake.h worker.h
+max.o: max.c max.h ewmh.h ewmh_state.h font.h atom.h JBWMClient.h monitor.h move_resize.h new.h property.h size_hints.h title_bar.h transaction.h
+monitor.o: monitor.c monitor.h JBWMScreen.h log.h screen.h
+move_resize.o: move_resize.c move_resize.h JBWMClient.h font.h log.h shape.h title_bar.h
 mwm.o: mwm.c mwm.h ewmh.h atom.h JBWMClient.h log.h mwmproto.h util.h
-new.o: new.c new.h client.h config.h ewmh.h geometry.h atom.h JBWMClient.h keys.h log.h mwm.h select.h shape.h snap.h util.h vdesk.h
-select.o: select.c select.h client.h ewmh.h ewmh_state.h atom.h JBWMClient.h util.h
-shape.o: shape.c shape.h JBWMClient.h log.h
-snap.o: snap.c snap.h config.h JBWMClient.h JBWMPoint.h JBWMSize.h
-title_bar.o: title_bar.c title_bar.h config.h draw.h ewmh.h ewmh_state.h font.h atom.h move_resize.h util.h wm_state.h
+new.o: new.c new.h client.h config.h crossing.h ewmh.h geometry.h atom.h JBWMClient.h keys.h log.h move_resize.h mwm.h place.h select.h shape.h snap.h title_bar.h util.h vdesk.h
+place.o: place.c place.h JBWMClient.h JBWMScreen.h command_line.h macros.h monitor.h
+property.o: property.c property.h JBWMClient.h ewmh.h move_resize.h mwm.h title_bar.h util.h worker.h
+restart.o: restart.c restart.h JBWMClient.h JBWMScreen.h client.h log.h new.h select.h util.h wake.h
+scenario.o: scenario.c JBWMClient.h JBWMScreen.h atom.h client.h display.h events.h fake_x.h font.h jbwm.h keys.h snap.h
+screen.o: screen.c screen.h JBWMScreen.h
+select.o: select.c select.h client.h ewmh.h ewmh_state.h atom.h JBWMClient.h max.h util.h
+shape.o: shape.c shape.h JBWMClient.h ewmh.h log.h move_resize.h mwm.h title_bar.h transaction.h
+size_hints.o: size_hints.c size_hints.h JBWMClient.h macros.h
+snap.o: snap.c snap.h config.h JBWMClient.h JBWMScreen.h JBWMPoint.h
+startup.o: startup.c startup.h command_line.h
+title_bar.o: title_bar.c title_bar.h config.h draw.h ewmh.h ewmh_state.h font.h atom.h move_resize.h transaction.h util.h wm_state.h
+trace.o: trace.c trace.h
+transaction.o: transaction.c transaction.h JBWMClient.h ewmh_state.h move_resize.h title_bar.h
 util.o: util.c util.h
-vdesk.o: vdesk.c vdesk.h client.h config.h draw.h ewmh.h font.h log.h atom.h JBWMClient.h JBWMScreen.h util.h
+vdesk.o: vdesk.c vdesk.h client.h config.h crossing.h draw.h ewmh.h font.h log.h atom.h max.h JBWMClient.h JBWMScreen.h select.h util.h
+wake.o: wake.c wake.h
 wm_state.o: wm_state.c wm_state.h ewmh.h ewmh_state.h atom.h log.h util.h
+worker.o: worker.c worker.h log.h util.h
@@ -2,12 +2,14 @@
 #include "display.h"
 #include <X11/Xproto.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include "client.h"
 #include "config.h"
 #include "log.h"
 #include "util.h"
+#include "worker.h"
 static struct JBWMClient ** current_client;
 static struct JBWMClient ** head_client;
 void jbwm_set_up_error_handler(struct JBWMClient ** head_client_arg,
@@ -16,10 +18,12 @@ void jbwm_set_up_error_handler(struct JBWMClient ** head_client_arg,
   current_client=current_client_arg;
 }
 __attribute__((pure))
-static int handle_xerror(Display * d __attribute__((unused)),
-  XErrorEvent * e)
+static int handle_xerror(Display * d, XErrorEvent * e)
 {
   struct JBWMClient *c;
+  // The worker reads windows which may have gone; that is all.
+  if (jbwm_is_worker_display(d))
+    return 0;
   switch (e->error_code) {
   case BadAccess:
     if (e->request_code == X_ChangeWindowAttributes)
@@ -42,10 +46,15 @@ static int handle_xerror(Display * d __attribute__((unused)),
 Display * jbwm_open_display(void)
 {
   Display * display;
+  /* Before any connection is opened, as the startup scan of each screen
+   * and the worker use Xlib from threads of their own.  */
+  XInitThreads();
   errno = ECONNREFUSED; // Default error message
   display=XOpenDisplay(NULL);
   if(!display)
     jbwm_error(getenv("DISPLAY"));
+  // Launched programs must not inherit the connection.
+  fcntl(ConnectionNumber(display), F_SETFD, FD_CLOEXEC);
   XSetErrorHandler(handle_xerror);
   return display;
 }
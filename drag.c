@@ -2,10 +2,14 @@
 #include "drag.h"
 #include "font.h"
 #include "JBWMClient.h"
+#include "JBWMScreen.h"
 #include "move_resize.h"
+#include "shape.h"
+#include "size_hints.h"
 #include "snap.h"
 #include <stdlib.h>
 #include <X11/cursorfont.h>
+#include <X11/extensions/shape.h>
 enum {
   JBWMMouseMask = ButtonPressMask | ButtonReleaseMask
   | PointerMotionMask
@@ -23,19 +27,47 @@ static inline void query_pointer(Display * dpy, Window w,
   p[0] = x;
   p[1] = y;
 }
+// Borderless clients, or a server without SHAPE, are moved live instead.
+static bool has_outline(struct JBWMClient * c)
+{
+  return c->opt.border && jbwm_get_shape_event(c->screen->xlib->display)
+    >= 0;
+}
+static Window new_outline(struct JBWMScreen * s)
+{
+  return XCreateWindow(s->xlib->display, s->xlib->root, 0, 0, 1, 1, 0,
+    CopyFromParent, CopyFromParent, CopyFromParent,
+    CWOverrideRedirect | CWBackPixel, &(XSetWindowAttributes){
+      .override_redirect = true, .background_pixel = s->pixels.fg});
+}
+/* The outline is a window of its own, shaped to a one pixel frame, so a
+ * step costs one request however large the client and nothing under it
+ * is drawn over.  It is only reshaped when its size changes.  */
 __attribute__((nonnull))
 static void draw_outline(struct JBWMClient * c)
 {
-  if(c->opt.border){
-    uint8_t const fh=c->screen->font_height, o = (c->opt.no_title_bar^1)*fh;
-    const union JBWMRectangle * g = &c->size;
-    enum { BORDER = 1 };
-    Display * d = c->screen->xlib->display;
-    XDrawRectangle(d, c->screen->xlib->root, c->screen->border_gc,
-      g->x, g->y - o, g->width + BORDER, g->height + BORDER + o);
-  } else {
+  static Window shaped;
+  static uint16_t shaped_width, shaped_height;
+  struct JBWMScreen * s = c->screen;
+  Display * d = s->xlib->display;
+  const uint8_t o = (c->opt.no_title_bar ^ 1) * s->font_height;
+  const union JBWMRectangle * g = &c->size;
+  const uint16_t w = g->width + 2, h = g->height + o + 2;
+  if (!has_outline(c)) {
     jbwm_move_resize(c);
+    return;
+  }
+  if (!s->outline)
+    s->outline = new_outline(s);
+  if (s->outline != shaped || w != shaped_width || h != shaped_height) {
+    XShapeCombineRectangles(d, s->outline, ShapeBounding, 0, 0,
+      (XRectangle[]){{0, 0, w, 1}, {0, h - 1, w, 1}, {0, 0, 1, h},
+      {w - 1, 0, 1, h}}, 4, ShapeSet, Unsorted);
+    shaped = s->outline;
+    shaped_width = w;
+    shaped_height = h;
   }
+  XMoveResizeWindow(d, s->outline, g->x, g->y - o, w, h);
 }
 static void drag_event_loop(struct JBWMClient * c,
   struct JBWMClient ** head_client, int16_t * start, bool const resize)
@@ -50,7 +82,6 @@ static void drag_event_loop(struct JBWMClient * c,
     XMaskEvent(d, JBWMMouseMask, &e);
     if(e.type==MotionNotify){
       int16_t p[]={e.xmotion.x,e.xmotion.y};
-      draw_outline(c);
       if(resize){
         /* Compute distance.  */
         p[0]=abs(g->array[0]-p[0]);
@@ -58,6 +89,7 @@ static void drag_event_loop(struct JBWMClient * c,
         /* Avoid client crashes if the axis geometry is 0.  */
         g->array[2]=p[0]>0?p[0]:1;
         g->array[3]=p[1]>0?p[1]:1;
+        jbwm_constrain_size(c);
       } else { /* move */
         p[0]+=start[0];
         p[1]+=start[1];
@@ -65,7 +97,7 @@ static void drag_event_loop(struct JBWMClient * c,
         g->array[1]=p[1];
         jbwm_snap_client(c, head_client);
       }
-      draw_outline(c); /* Erase the previous outline.  */
+      draw_outline(c);
       /* Test that this function remains an atomic call by
          using its recursive definition.
          drag_event_loop(c, start, resize);  */
@@ -93,8 +125,12 @@ void jbwm_drag(struct JBWMClient * c, struct JBWMClient ** head_client,
     /* Adjust for the current window position to find the offset.  */
     start[0]=g->array[0]-start[0];
     start[1]=g->array[1]-start[1];
-    drag_event_loop(c, head_client, start, resize);
     draw_outline(c);
+    if (has_outline(c))
+      XMapRaised(d, c->screen->outline);
+    drag_event_loop(c, head_client, start, resize);
+    if (has_outline(c))
+      XUnmapWindow(d, c->screen->outline);
     XUngrabPointer(d, CurrentTime);
     jbwm_move_resize(c);
   }
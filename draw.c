@@ -13,3 +13,14 @@ void jbwm_draw_string(struct JBWMScreen *s, Window const target,
     /*jbwm_get_font_ascent()+*/y, text, length);
 #endif//JBWM_USE_XFT
 }
+uint16_t jbwm_get_text_width(Display * d, char * text, size_t const length)
+{
+#ifdef JBWM_USE_XFT
+  XGlyphInfo i;
+  XftTextExtentsUtf8(d, jbwm_get_font(), (XftChar8 *)text, length, &i);
+  return i.xOff;
+#else//!JBWM_USE_XFT
+  (void)d;
+  return XTextWidth(jbwm_get_font(), text, length);
+#endif//JBWM_USE_XFT
+}
@@ -3,4 +3,6 @@
 #include "JBWMScreen.h"
 void jbwm_draw_string(struct JBWMScreen *s, Window const target,
   int16_t const x, int16_t const y, char *text, size_t const length);
+// Return the width of text in pixels, as drawn by jbwm_draw_string.
+uint16_t jbwm_get_text_width(Display * d, char * text, size_t const length);
 #endif//!JBWM_DRAW_H
@@ -4,28 +4,59 @@
 // See README for license and other details.
 #include "events.h"
 #include <X11/Xatom.h>
+#include "atom.h"
 #include "button_event.h"
 #include "client.h"
+#include "control.h"
+#include "crossing.h"
 #include "ewmh.h"
 #include "ewmh_client.h"
 #include "ewmh_client_list.h"
+#include "exec.h"
+#include "export.h"
 #include "JBWMScreen.h"
 #include "key_event.h"
+#include "keys.h"
+#include "max.h"
 #include "log.h"
+#include "monitor.h"
 #include "move_resize.h"
 #include "new.h"
+#include "property.h"
+#include "restart.h"
+#include "screen.h"
 #include "select.h"
+#include "shape.h"
+#include "size_hints.h"
 #include "title_bar.h"
+#include "trace.h"
 #include "util.h"
+#include "vdesk.h"
+#include "wake.h"
 #include "wm_state.h"
+#include "worker.h"
+#include <poll.h>
 // Set log level for events
 #define JBWM_LOG_EVENTS 1
-static struct JBWMScreen * get_screen(struct JBWMScreen *s,
-  const Window root, const int i) {
-  return RootWindowOfScreen(s[i].xlib) == root ? s
-  // Check that the next iteration is not outside array bounds, using
-  // suppporting field as validation
-  : s[i + 1].supporting ? get_screen(s,root, i + 1) : s;
+/* Keycodes and the NumLock modifier may have moved, so rebuild the key
+ * table and grab again on every root.  */
+static void jbwm_handle_MappingNotify(XMappingEvent * e)
+{
+  XRefreshKeyboardMapping(e);
+  if (e->request != MappingPointer) {
+    Display * d = e->display;
+    int i;
+    jbwm_update_keys(d);
+    for (i = ScreenCount(d); i--;)
+      jbwm_grab_root_keys(d, RootWindow(d, i));
+  }
+}
+static void take_properties(struct JBWMClient * head_client)
+{
+  struct JBWMProperty p;
+  while (jbwm_take_property(&p))
+    jbwm_apply_property(jbwm_find_client(head_client, p.window), p.atom,
+      p.value);
 }
 static void jbwm_handle_PropertyNotify(XEvent * ev, struct JBWMClient * c)
 {
@@ -33,8 +64,11 @@ static void jbwm_handle_PropertyNotify(XEvent * ev, struct JBWMClient * c)
     XPropertyEvent * e = &ev->xproperty;
     if (e->state != PropertyNewValue)
       return;
-    if (e->atom == XA_WM_NAME)
-      jbwm_update_title_bar(c);
+    if (e->atom == XA_WM_NAME
+      || e->atom == jbwm_atoms[JBWM_MOTIF_WM_HINTS])
+      jbwm_read_property(c, e->atom);
+    else if (e->atom == XA_WM_NORMAL_HINTS)
+      jbwm_invalidate_size_hints(c);
     else {
       Display * d = e->display;
 #if JBWM_LOG_EVENTS > 3
@@ -46,7 +80,7 @@ static void jbwm_handle_PropertyNotify(XEvent * ev, struct JBWMClient * c)
   }
 }
 static void jbwm_handle_MapRequest(XEvent * ev, struct JBWMClient * c,
-  struct JBWMScreen * s, struct JBWMClient ** head_client,
+  struct JBWMClient ** head_client,
   struct JBWMClient ** current_client) {
   if (!c) {
     XMapRequestEvent * e = &ev->xmaprequest;
@@ -58,7 +92,7 @@ static void jbwm_handle_MapRequest(XEvent * ev, struct JBWMClient * c,
       serial = e->serial;
       JBWM_LOG("jbwm_handle_MapRequest(), send_event:%d",
         e->send_event);
-      jbwm_new_client(get_screen(s, e->parent, 0), head_client,
+      jbwm_new_client(jbwm_get_screen(e->parent), head_client,
         current_client, e->window);
     }
   }
@@ -87,86 +121,176 @@ static void jbwm_handle_ConfigureRequest(XEvent * ev, struct JBWMClient * c)
       .border_width = e->border_width,
       .sibling = e->above, .stack_mode = e->detail});
   XSync(e->display, false);
-  if (c)
+  if (c) {
+    // The request may have changed the client behind our back.
+    jbwm_invalidate_geometry(c);
     jbwm_move_resize(c);
+  }
 }
 static void jbwm_handle_EnterNotify(XEvent * ev, struct JBWMClient * c,
   struct JBWMClient ** current_client)
 {
-  if (c && ev->xcrossing.window == c->parent)
+  // Entering the focused client, as after a warp into it, changes nothing.
+  if (c && c != *current_client && ev->xcrossing.window == c->parent
+    && !jbwm_is_ignored_enter(&ev->xcrossing))
     jbwm_select_client(c, current_client);
 }
 static void jbwm_handle_Expose(XEvent * ev, struct JBWMClient * c)
 {
-  if (c && !ev->xexpose.count)
+  if (ev->xexpose.count)
+    return; // Only the last of a series redraws.
+  if (c)
     jbwm_update_title_bar(c);
+  else
+    jbwm_expose_osd(ev->xexpose.window);
+}
+static void next_event(struct JBWMScreen * s, XEvent * ev,
+  struct JBWMClient ** head_client, struct JBWMClient ** current_client)
+{
+  Display * d = s->xlib->display;
+  /* Wait here rather than in XNextEvent, so that the desktop indicator is
+   * hidden once it times out, SIGHUP and SIGCHLD wake the wait, and
+   * control commands and the worker's results are served.  */
+  while (!XPending(d)) {
+    struct pollfd p[] = {{.fd = ConnectionNumber(d), .events = POLLIN},
+      {.fd = jbwm_get_control_fd(), .events = POLLIN},
+      {.fd = jbwm_get_worker_fd(), .events = POLLIN},
+      {.fd = jbwm_get_wake_fd(), .events = POLLIN}};
+    jbwm_export_stacking(s, *head_client, *current_client);
+    // Its round trips may have queued events, which poll would not see.
+    if (QLength(d))
+      break;
+    /* Cleared before the checks, so a signal after them leaves the pipe
+     * readable and poll returns at once.  */
+    jbwm_clear_wake();
+    jbwm_reap_children();
+    if (jbwm_get_restart_requested())
+      jbwm_restart(d, *head_client, *current_client);
+    // poll ignores entries whose descriptors are negative.
+    if (!poll(p, 4, jbwm_get_osd_timeout()))
+      jbwm_hide_osd();
+    else {
+      if (p[1].revents & POLLIN)
+        jbwm_handle_control(s, head_client, current_client);
+      if (p[2].revents & POLLIN) {
+        take_properties(*head_client);
+        // No event may follow, so publish what the results changed.
+        jbwm_export(s, *head_client, *current_client, PropertyNotify);
+      }
+    }
+  }
+  XNextEvent(d, ev);
+}
+void jbwm_handle_event(struct JBWMScreen * s, XEvent * ev,
+  struct JBWMClient ** head_client, struct JBWMClient ** current_client)
+{
+  static bool client_list_stale;
+  Display * d = s->xlib->display;
+  struct JBWMClient * c;
+  enum JBWMHandler h = JBWM_HANDLER_NONE;
+  jbwm_trace_begin(ev);
+  c = jbwm_find_client(*head_client, ev->xany.window);
+  switch (ev->type) {
+  case ConfigureNotify:
+    h = JBWM_HANDLER_CONFIGURE_NOTIFY;
+    jbwm_handle_ConfigureNotify(ev,c);
+    break;
+  case ConfigureRequest:
+    h = JBWM_HANDLER_CONFIGURE_REQUEST;
+    jbwm_handle_ConfigureRequest(ev,c);
+    break;
+  case KeyPress:
+    JBWM_LOG("c: %d, window: %d, root: %d", (int)c,
+      (int)ev->xkey.window, (int)ev->xkey.root);
+    if (!c)
+      c = *current_client;
+    h = JBWM_HANDLER_KEY_EVENT;
+    // Keys are grabbed on the roots, so act on the screen pressed on.
+    jbwm_handle_key_event(jbwm_get_screen(ev->xkey.root), c, head_client,
+      current_client, &ev->xkey);
+    break;
+  case KeyRelease:
+    h = JBWM_HANDLER_KEY_RELEASE;
+    jbwm_handle_key_release(&ev->xkey, current_client);
+    break;
+  case ButtonPress:
+    h = JBWM_HANDLER_BUTTON_EVENT;
+    jbwm_handle_button_event(&ev->xbutton, c, head_client,
+      current_client);
+    break;
+  case EnterNotify:
+    h = JBWM_HANDLER_ENTER_NOTIFY;
+    jbwm_handle_EnterNotify(ev, c, current_client);
+    break;
+  case Expose:
+    h = JBWM_HANDLER_EXPOSE;
+    jbwm_handle_Expose(ev,c);
+    break;
+  case CreateNotify:
+  case DestroyNotify:
+    h = JBWM_HANDLER_CLIENT_LIST;
+    client_list_stale = true;
+    break;
+  case UnmapNotify:
+    if (c && (c->opt.remove || (c->ignore_unmap--<1))) {
+      h = JBWM_HANDLER_CLIENT_FREE;
+      jbwm_client_free(c, head_client, current_client);
+    }
+    break;
+  case MapRequest:
+    h = JBWM_HANDLER_MAP_REQUEST;
+    jbwm_handle_MapRequest(ev, c, head_client, current_client);
+    break;
+  case PropertyNotify:
+    h = JBWM_HANDLER_PROPERTY_NOTIFY;
+    jbwm_handle_PropertyNotify(ev,c);
+    break;
+  case ColormapNotify:
+    h = JBWM_HANDLER_COLORMAP_NOTIFY;
+    jbwm_handle_ColormapNotify(ev,c);
+    break;
+  case ClientMessage:
+    h = JBWM_HANDLER_CLIENT_MESSAGE;
+    jbwm_ewmh_handle_client_message(&ev->xclient, c, head_client,
+      current_client);
+    break;
+  case MappingNotify:
+    h = JBWM_HANDLER_MAPPING_NOTIFY;
+    jbwm_handle_MappingNotify(&ev->xmapping);
+    break;
+    // ignore
+  case ButtonRelease:
+  case MapNotify:
+  case MotionNotify:
+  case ReparentNotify:
+    break;
+  default:
+    if (c && ev->type == jbwm_get_shape_event(d)) {
+      h = JBWM_HANDLER_SHAPE_NOTIFY;
+      jbwm_handle_ShapeNotify(c, ev);
+    } else if (ev->type == jbwm_get_monitor_event(d)) {
+      h = JBWM_HANDLER_MONITOR_EVENT;
+      jbwm_handle_monitor_event(ev);
+    }
+    break;
+  }
+  // Published when fullscreen mode ends, as nothing is shown over it.
+  if (client_list_stale && !jbwm_get_fullscreen_mode()) {
+    jbwm_ewmh_update_client_list(*head_client);
+    client_list_stale = false;
+  }
+  jbwm_trace_end(d, h);
+  /* Between events too, so a busy connection does not hold results
+   * back, and before the export, so they are published with it.  */
+  take_properties(*head_client);
+  jbwm_export(s, *head_client, *current_client, ev->type);
 }
 void jbwm_events_loop(struct JBWMScreen * s, struct JBWMClient ** head_client,
   struct JBWMClient ** current_client)
 {
-  Display *d;
-  d=s->xlib->display;
   for (;;) {
     XEvent ev;
-    XNextEvent(d, &ev);
-    struct JBWMClient * c = jbwm_find_client(*head_client, ev.xany.window);
-    if (c)
-      s = c->screen;
-    switch (ev.type) {
-    case ConfigureNotify:
-      jbwm_handle_ConfigureNotify(&ev,c);
-      break;
-    case ConfigureRequest:
-      jbwm_handle_ConfigureRequest(&ev,c);
-      break;
-    case KeyPress:
-      JBWM_LOG("c: %d, window: %d, root: %d", (int)c,
-        (int)ev.xkey.window, (int)ev.xkey.root);
-      if (!c)
-        c = *current_client;
-      jbwm_handle_key_event(s, c, head_client, current_client, &ev.xkey);
-      break;
-    case ButtonPress:
-      jbwm_handle_button_event(&ev.xbutton, c, head_client,
-        current_client);
-      break;
-    case EnterNotify:
-      jbwm_handle_EnterNotify(&ev, c, current_client);
-      break;
-    case Expose:
-      jbwm_handle_Expose(&ev,c);
-      break;
-    case CreateNotify:
-    case DestroyNotify:
-      jbwm_ewmh_update_client_list(*head_client);
-      break;
-    case UnmapNotify:
-      if (c && (c->opt.remove || (c->ignore_unmap--<1)))
-        jbwm_client_free(c, head_client, current_client);
-      break;
-    case MapRequest:
-      jbwm_handle_MapRequest(&ev, c, s, head_client, current_client);
-      break;
-    case PropertyNotify:
-      jbwm_handle_PropertyNotify(&ev,c);
-      break;
-    case ColormapNotify:
-      jbwm_handle_ColormapNotify(&ev,c);
-      break;
-    case ClientMessage:
-      jbwm_ewmh_handle_client_message(&ev.xclient, c, head_client,
-        current_client);
-      break;
-      // ignore
-    case ButtonRelease:
-    case KeyRelease:
-    case MapNotify:
-    case MappingNotify:
-    case MotionNotify:
-    case ReparentNotify:
-    default:
-      break;
-    }
+    next_event(s, &ev, head_client, current_client);
+    jbwm_handle_event(s, &ev, head_client, current_client);
   }
 }
-
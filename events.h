@@ -4,8 +4,14 @@
 // See README for license and other details.
 #ifndef JBWM_EVENTS_H
 #define JBWM_EVENTS_H
+#include <X11/Xlib.h>
 struct JBWMClient;
 struct JBWMScreen; 
+/* Handle ev as the loop does once it has been read.  This is all of the
+ * loop but its wait, so a fake server can drive it, as scenario.c does. */
+void jbwm_handle_event(struct JBWMScreen * s, XEvent * ev,
+  struct JBWMClient ** head_client, struct JBWMClient ** current_client)
+__attribute__((nonnull));
 void jbwm_events_loop(struct JBWMScreen * s, struct JBWMClient ** head_client,
   struct JBWMClient ** current_client) __attribute__((noreturn));
 #endif /* ! JBWM_EVENTS_H */
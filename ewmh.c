@@ -33,7 +33,8 @@ void jbwm_ewmh_set_allowed_actions(Display * d,
 }
 static void init_desktops(Display * d,struct JBWMScreen * s)
 {
-  int32_t data[2];
+  // Xlib reads items of format 32 from longs.
+  long data[2];
   Window root=s->xlib->root;
   data[0]=s->xlib->width;
   data[1]=s->xlib->height;
@@ -45,8 +46,9 @@ static void init_desktops(Display * d,struct JBWMScreen * s)
   data[0]=JBWM_NUMBER_OF_DESKTOPS;
   XChangeProperty(d, root, jbwm_atoms[JBWM_NET_NUMBER_OF_DESKTOPS],
     XA_CARDINAL, 32, PropModeReplace, (unsigned char*)data, 1);
+  data[0]=s->vdesk;
   XChangeProperty(d, root, jbwm_atoms[JBWM_NET_CURRENT_DESKTOP],
-    XA_CARDINAL, 32, PropModeReplace, (unsigned char*)&s->vdesk, 1);
+    XA_CARDINAL, 32, PropModeReplace, (unsigned char*)data, 1);
   XChangeProperty(d, root, jbwm_atoms[JBWM_NET_VIRTUAL_ROOTS],
     XA_WINDOW, 32, PropModeReplace, (unsigned char*)&root, 1);
 }
@@ -59,7 +61,7 @@ static Window init_supporting(Display * d,Window const r)
   XChangeProperty(d, w, jbwm_atoms[JBWM_NET_SUPPORTING_WM_CHECK],
     XA_WINDOW, 32, PropModeReplace, (unsigned char *)&w, 1);
   XChangeProperty(d, w, jbwm_atoms[JBWM_NET_WM_PID], XA_CARDINAL,
-    32, PropModeReplace, (unsigned char *)&(pid_t){getpid()},1);
+    32, PropModeReplace, (unsigned char *)&(long){getpid()},1);
   XChangeProperty(d, w, jbwm_atoms[JBWM_NET_WM_NAME], XA_STRING,
     8, PropModeReplace, (unsigned char *)JBWM_NAME, sizeof(JBWM_NAME));
   return w;
@@ -86,7 +88,7 @@ void jbwm_ewmh_init_screen(Display * d, struct JBWMScreen * s)
 // Required by wm-spec:
 void jbwm_set_frame_extents(struct JBWMClient * c)
 {
-  static uint32_t f[4];
+  static long f[4];
   Atom a;
   JBWM_LOG("jbwm_set_frame_extents()");
   // Fields: left,right,top,bottom
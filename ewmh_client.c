@@ -6,6 +6,7 @@
 #include "ewmh.h"
 #include "ewmh_wm_state.h"
 #include "atom.h"
+#include "screen.h"
 #include "select.h"
 #include "util.h"
 #include "vdesk.h"
@@ -79,7 +80,9 @@ void jbwm_ewmh_handle_client_message(XClientMessageEvent * e,
   debug_client_message(e);
   if(!(c && client_specific_message(e, c, head_client, current_client, t))){
     if (t == jbwm_atoms[JBWM_NET_CURRENT_DESKTOP]) {
-      jbwm_set_vdesk(c->screen, *head_client, e->data.l[0]);
+      // Pagers send this to the root, which is no client.
+      jbwm_set_vdesk(c ? c->screen : jbwm_get_screen(e->window),
+        current_client, e->data.l[0]);
     } else if (t == jbwm_atoms[JBWM_NET_MOVERESIZE_WINDOW]) {
       // If something else moves the window:
       handle_moveresize(e);
@@ -3,6 +3,7 @@
 #include "ewmh_state.h"
 #include "client.h"
 #include "drag.h"
+#include "JBWMClient.h"
 #include "ewmh.h"
 #include "jbwm.h"
 #include "atom.h"
@@ -12,6 +13,8 @@
 #include "util.h"
 #include "wm_state.h"
 #include <X11/Xatom.h>
+#include <stdlib.h>
+#include <string.h>
 // Remove specified atom from WM_STATE
 void jbwm_ewmh_remove_state(Display * display,
   const Window window, const Atom state)
@@ -53,4 +56,69 @@ void jbwm_ewmh_add_state(Display * d, const Window w,
     XA_ATOM, 32, PropModePrepend,
     (unsigned char *)&state, 1);
 }
-
+__attribute__((const))
+static uint16_t state_bit(const enum JBWMAtomName state)
+{
+  return 1 << (state - JBWM_NET_WM_STATE_STICKY);
+}
+static bool is_pending(const uint16_t mask, const Atom a)
+{
+  uint8_t i;
+  for (i = JBWM_NET_WM_STATE_STICKY; i <= JBWM_NET_WM_STATE_FOCUSED; ++i)
+    if ((mask & state_bit(i)) && jbwm_atoms[i] == a)
+      return true;
+  return false;
+}
+void jbwm_ewmh_set_state(struct JBWMClient * c,
+  const enum JBWMAtomName state, const bool add)
+{
+  struct JBWMClientTransaction * t = &c->transaction;
+  const uint16_t bit = state_bit(state);
+  if (add) {
+    t->state_add |= bit;
+    t->state_remove &= ~bit;
+  } else {
+    t->state_remove |= bit;
+    t->state_add &= ~bit;
+  }
+  if (!t->depth)
+    jbwm_ewmh_flush_state(c);
+}
+/* Write the accumulated changes with at most one read and one write of
+ * the property.  Pure additions need no read at all, and are prepended,
+ * as they are when the property cannot be read.  */
+void jbwm_ewmh_flush_state(struct JBWMClient * c)
+{
+  struct JBWMClientTransaction * t = &c->transaction;
+  const Atom wm_state = jbwm_atoms[JBWM_NET_WM_STATE];
+  Display * d = c->screen->xlib->display;
+  Atom n[JBWM_NET_WM_STATE_FOCUSED - JBWM_NET_WM_STATE_STICKY + 1];
+  uint8_t i, count = 0;
+  if (!(t->state_add | t->state_remove))
+    return;
+  for (i = JBWM_NET_WM_STATE_STICKY; i <= JBWM_NET_WM_STATE_FOCUSED; ++i)
+    if (t->state_add & state_bit(i))
+      n[count++] = jbwm_atoms[i];
+  if (t->state_remove) {
+    uint16_t len, j, k;
+    Atom * a = jbwm_get_property(d, c->window, wm_state, &len), * m;
+    if (a && (m = malloc((len + count) * sizeof(Atom)))) {
+      // Drop removed atoms, and added ones to avoid duplicates.
+      for (j = k = 0; j < len; ++j)
+        if (!is_pending(t->state_add | t->state_remove, a[j]))
+          m[k++] = a[j];
+      // The additions follow, so all is one write.
+      memcpy(m + k, n, count * sizeof(Atom));
+      XChangeProperty(d, c->window, wm_state, XA_ATOM, 32,
+        PropModeReplace, (unsigned char *)m, k + count);
+      free(m);
+      count = 0;
+    }
+    if (a)
+      XFree(a);
+  }
+  if (count)
+    XChangeProperty(d, c->window, wm_state, XA_ATOM, 32,
+      PropModePrepend, (unsigned char *)n, count);
+  t->state_add = t->state_remove = 0;
+}
@@ -3,8 +3,15 @@
 #define JBWM_EWMH_STATE_H
 #include <X11/Xlib.h>
 #include <stdbool.h>
+#include "JBWMAtomName.h"
 struct JBWMClient;
 void jbwm_ewmh_add_state(Display * d, const Window w, Atom state);
 bool jbwm_ewmh_get_state(Display * d, const Window w, const Atom state);
 void jbwm_ewmh_remove_state(Display * d, const Window w, const Window state);
+/* Add or remove one of the _NET_WM_STATE atoms on c's window.  This is
+ * deferred while c is in a transaction.  */
+void jbwm_ewmh_set_state(struct JBWMClient * c,
+  const enum JBWMAtomName state, const bool add) __attribute__((nonnull));
+// Write state changes accumulated by jbwm_ewmh_set_state.
+void jbwm_ewmh_flush_state(struct JBWMClient * c) __attribute__((nonnull));
 #endif//JBWM_EWMH_STATE_H
@@ -7,6 +7,7 @@
 #include "ewmh_state.h"
 #include "log.h"
 #include "max.h"
+#include "transaction.h"
 #include "util.h"
 /*      Reference, per wm-spec:
         window  = the respective client window
@@ -26,7 +27,7 @@ static void set_state(struct JBWMClient * c,
     if(atom==jbwm_atoms[JBWM_NET_WM_STATE_FULLSCREEN])
       (add?jbwm_set_fullscreen:jbwm_set_not_fullscreen)(c);
     else if(atom==jbwm_atoms[JBWM_NET_WM_STATE_STICKY])
-      c->opt.sticky=add;
+      jbwm_set_sticky(c, add);
     else if(atom==jbwm_atoms[JBWM_NET_WM_STATE_ABOVE])
       add = !add; // fall through
     else if(atom==jbwm_atoms[JBWM_NET_WM_STATE_BELOW])
@@ -44,39 +45,38 @@ static void set_state(struct JBWMClient * c,
 }
 __attribute__((nonnull))
 static void check_state(XClientMessageEvent * e,	// event data
-  Atom const atom, // state to test
+  enum JBWMAtomName const name, // state to test
   struct JBWMClient * c){
   // 2 atoms can be set at once
   long * l = &e->data.l[0];
+  Atom const atom = jbwm_atoms[name];
   const bool set = l[1] == (long)atom || l[2] == (long)atom;
   if(!set)
     return;
-  Display * d = e->display;
+  bool add;
   switch (e->data.l[0]) {
   default:
   case 0:	// remove
-    set_state(c, false, atom);
-    jbwm_ewmh_remove_state(d, e->window, atom);
+    add = false;
     break;
   case 1:	// add
-    set_state(c,true,atom);
-    jbwm_ewmh_add_state(d, e->window, atom);
+    add = true;
     break;
-  case 2: { // toggle
-    const bool add = !jbwm_ewmh_get_state(e->display,
-      e->window, atom);
-    set_state(c,add,atom);
-    (add ? jbwm_ewmh_add_state : jbwm_ewmh_remove_state)
-    (d, e->window, atom);
-  }
+  case 2: // toggle
+    add = !jbwm_ewmh_get_state(e->display, e->window, atom);
   }
+  set_state(c, add, atom);
+  jbwm_ewmh_set_state(c, name, add);
 }
 void jbwm_ewmh_handle_wm_state_changes(XClientMessageEvent * e,
   struct JBWMClient * c){
-  check_state(e, jbwm_atoms[JBWM_NET_WM_STATE_ABOVE], c);
-  check_state(e, jbwm_atoms[JBWM_NET_WM_STATE_BELOW], c);
-  check_state(e, jbwm_atoms[JBWM_NET_WM_STATE_FULLSCREEN], c);
-  check_state(e, jbwm_atoms[JBWM_NET_WM_STATE_MAXIMIZED_HORZ], c);
-  check_state(e, jbwm_atoms[JBWM_NET_WM_STATE_MAXIMIZED_VERT], c);
-  check_state(e, jbwm_atoms[JBWM_NET_WM_STATE_STICKY], c);
+  // Both atoms of one message are committed together.
+  jbwm_begin(c);
+  check_state(e, JBWM_NET_WM_STATE_ABOVE, c);
+  check_state(e, JBWM_NET_WM_STATE_BELOW, c);
+  check_state(e, JBWM_NET_WM_STATE_FULLSCREEN, c);
+  check_state(e, JBWM_NET_WM_STATE_MAXIMIZED_HORZ, c);
+  check_state(e, JBWM_NET_WM_STATE_MAXIMIZED_VERT, c);
+  check_state(e, JBWM_NET_WM_STATE_STICKY, c);
+  jbwm_commit(c);
 }
@@ -1,15 +1,71 @@
 // Copyright 2020, Alisa Bedard <alisabedard@gmail.com>
 #include "exec.h"
-#include "config.h"
-#include <signal.h> // for signal()
-#include <stdlib.h>
-#include <unistd.h> // for fork(), execl()
+#include "log.h"
+#include "wake.h"
+#include <signal.h>
+#include <spawn.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/wait.h>
+extern char ** environ;
+enum { EXEC_MAX_ARGS = 32 };
+static volatile sig_atomic_t exited;
+static void handle_child(int sig __attribute__((unused)))
+{
+  exited = 1;
+  jbwm_wake();
+}
+void jbwm_set_up_exec(void)
+{
+  struct sigaction a;
+  memset(&a, 0, sizeof(a));
+  a.sa_handler = handle_child;
+  a.sa_flags = SA_RESTART | SA_NOCLDSTOP;
+  sigaction(SIGCHLD, &a, NULL);
+}
+void jbwm_reap_children(void)
+{
+  if (exited) {
+    exited = 0;
+    while (waitpid(-1, NULL, WNOHANG) > 0)
+      ;
+  }
+}
+/* Split command at blanks into argv, unless the shell is needed to
+ * interpret it.  Return the number of words, or 0 for the shell.  */
+static uint8_t split(char * command, char ** argv)
+{
+  uint8_t n = 0;
+  if (strpbrk(command, "|&;<>()$`\\\"'*?[]#~=%{}!\n"))
+    return 0;
+  for (argv[n] = strtok(command, " \t"); argv[n];
+    argv[n] = strtok(NULL, " \t"))
+    if (++n == EXEC_MAX_ARGS)
+      return 0;
+  return n;
+}
 void jbwm_exec(const char * command)
 {
-  if (fork() == 0) { // child
-    execl("/bin/sh", "sh", "-c", command, NULL);
-    // This is only reached on error.
-    exit(1);
-  } else // in controlling process:
-    signal(SIGCHLD, SIG_IGN);
+  char buf[strlen(command) + 1], * argv[EXEC_MAX_ARGS + 1];
+  posix_spawnattr_t a;
+  sigset_t none;
+  pid_t pid;
+  int error;
+  posix_spawnattr_init(&a);
+  // Start the child with no signals blocked, whatever this thread has.
+  sigemptyset(&none);
+  posix_spawnattr_setsigmask(&a, &none);
+  posix_spawnattr_setflags(&a, POSIX_SPAWN_SETSIGMASK);
+  strcpy(buf, command);
+  if (split(buf, argv))
+    error = posix_spawnp(&pid, argv[0], NULL, &a, argv, environ);
+  else {
+    strcpy(buf, command); // split may have cut it up
+    error = posix_spawn(&pid, "/bin/sh", NULL, &a,
+      (char * []){"sh", "-c", buf, NULL}, environ);
+  }
+  if (error) {
+    JBWM_LOG("Could not run %s", command);
+  }
+  posix_spawnattr_destroy(&a);
 }
@@ -1,6 +1,10 @@
 // Copyright 2020, Alisa Bedard <alisabedard@gmail.com>
 #ifndef JBWM_EXEC_H
 #define JBWM_EXEC_H
-// Execute command as forked process.
-void jbwm_exec(const char * command);
+// Note exited children on SIGCHLD, to be reaped from the event loop.
+void jbwm_set_up_exec(void);
+void jbwm_reap_children(void);
+/* Execute command without copying the window manager, through the shell
+ * only if it uses shell syntax.  The X connection is closed on exec.  */
+void jbwm_exec(const char * command) __attribute__((nonnull));
 #endif//!JBWM_EXEC_H
@@ -0,0 +1,225 @@
+// Copyright 2020, Alisa Bedard
+#include "export.h"
+#include "JBWMClient.h"
+#include "JBWMScreen.h"
+#include "JBWMStateEntry.h"
+#include "JBWMStateHeader.h"
+#include "command_line.h"
+#include "log.h"
+#include "macros.h"
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+enum { EXPORT_CAPACITY = 1024 };
+// A frame's place in the stacking order, kept sorted by frame.
+struct Stacking {
+  Window frame;
+  uint16_t index;
+};
+static struct JBWMStateHeader * header;
+static struct JBWMStateEntry * entries; // follow the header
+// Entries are built here, then copied out only if they changed.
+static struct JBWMStateEntry scratch[EXPORT_CAPACITY];
+static struct Stacking * stacking;
+static size_t stacking_count;
+static bool restack = true;
+static char name[64];
+static void unlink_region(void)
+{
+  shm_unlink(name);
+}
+static void begin_write(void)
+{
+  __atomic_store_n(&header->sequence, header->sequence + 1,
+    __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+static void end_write(void)
+{
+  __atomic_store_n(&header->sequence, header->sequence + 1,
+    __ATOMIC_RELEASE);
+}
+void jbwm_set_up_export(Display * d)
+{
+  const size_t size = sizeof(*header) + sizeof(scratch);
+  void * m = MAP_FAILED;
+  struct stat st;
+  char * p;
+  int fd;
+  if (!jbwm_get_export())
+    return;
+  snprintf(name, sizeof(name), "/jbwm-%s", DisplayString(d));
+  for (p = name + 1; *p; ++p)
+    if (*p == '/')
+      *p = '_';
+  fd = shm_open(name, O_RDWR | O_CREAT, 0600);
+  if (fd < 0)
+    return;
+  /* A restart reopens its own region, but another user may have created
+   * the name first, to feed forged state to every reader.  */
+  if (fstat(fd, &st) || st.st_uid != getuid()
+    || (st.st_mode & 0777) != 0600) {
+    JBWM_LOG("Refusing %s, which another user may write", name);
+    close(fd);
+    return;
+  }
+  if (!ftruncate(fd, size))
+    m = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (m == MAP_FAILED)
+    return;
+  header = m;
+  entries = (struct JBWMStateEntry *)(header + 1);
+  // A restart finds its own region, so keep the sequence counting up.
+  if (header->magic != JBWM_STATE_MAGIC)
+    header->sequence = 0;
+  header->sequence &= ~1u;
+  begin_write();
+  header->magic = JBWM_STATE_MAGIC;
+  header->version = JBWM_STATE_VERSION;
+  header->header_size = sizeof(*header);
+  header->entry_size = sizeof(*entries);
+  header->capacity = EXPORT_CAPACITY;
+  header->count = 0;
+  end_write();
+  atexit(unlink_region);
+}
+static int compare_frames(const void * a, const void * b)
+{
+  const Window x = ((const struct Stacking *)a)->frame,
+        y = ((const struct Stacking *)b)->frame;
+  return (x > y) - (x < y);
+}
+static void query_stacking(struct JBWMScreen * s, const uint8_t n)
+{
+  uint8_t i;
+  stacking_count = 0;
+  for (i = 0; i < n; ++i) {
+    Window * w, d;
+    unsigned int m, j;
+    struct Stacking * p;
+    if (!XQueryTree(s[i].xlib->display, s[i].xlib->root, &d, &d, &w, &m))
+      continue;
+    p = realloc(stacking, (stacking_count + m) * sizeof(*p));
+    if (p) {
+      stacking = p;
+      for (j = 0; j < m; ++j)
+        stacking[stacking_count++] = (struct Stacking){w[j], j};
+    }
+    XFree(w);
+  }
+  qsort(stacking, stacking_count, sizeof(*stacking), compare_frames);
+  restack = false;
+}
+static uint16_t get_stacking(const Window frame)
+{
+  const struct Stacking key = {frame, 0},
+        * f = bsearch(&key, stacking, stacking_count, sizeof(key),
+          compare_frames);
+  return f ? f->index : 0;
+}
+static void get_entry(struct JBWMStateEntry * e, struct JBWMClient * c,
+  struct JBWMClient * current_client)
+{
+  const struct JBWMClientOptions * o = &c->opt;
+  const int16_t t = o->no_title_bar || o->fullscreen ? 0
+    : c->screen->font_height;
+  // Clear the padding and the end of the title, as entries are compared.
+  memset(e, 0, sizeof(*e));
+  e->window = c->window;
+  e->frame = c->parent;
+  e->x = c->size.x;
+  e->y = c->size.y - t;
+  e->width = c->size.width;
+  e->height = c->size.height + t;
+  e->stacking = get_stacking(c->parent);
+  e->flags = (c == current_client ? JBWM_STATE_FOCUSED : 0)
+    | (o->sticky ? JBWM_STATE_STICKY : 0)
+    | (o->shaded ? JBWM_STATE_SHADED : 0)
+    | (o->fullscreen ? JBWM_STATE_FULLSCREEN : 0)
+    | (o->max_horz ? JBWM_STATE_MAX_HORZ : 0)
+    | (o->max_vert ? JBWM_STATE_MAX_VERT : 0)
+    | (o->no_title_bar ? JBWM_STATE_NO_TITLE_BAR : 0)
+    | (!o->sticky && c->vdesk != c->screen->vdesk ? JBWM_STATE_HIDDEN : 0);
+  e->screen = c->screen->id;
+  e->desktop = c->vdesk;
+  if (c->title)
+    strncpy(e->title, c->title, sizeof(e->title) - 1);
+}
+// Return true if a and b differ in anything but their generation.
+static bool differ(const struct JBWMStateEntry * a,
+  const struct JBWMStateEntry * b)
+{
+  enum { SKIP = offsetof(struct JBWMStateEntry, window) };
+  return memcmp((const char *)a + SKIP, (const char *)b + SKIP,
+    sizeof(*a) - SKIP);
+}
+static uint8_t get_screens(struct JBWMScreen * s)
+{
+  return JB_MIN(ScreenCount(s->xlib->display), JBWM_STATE_SCREENS);
+}
+static void publish(struct JBWMScreen * s, struct JBWMClient * head_client,
+  struct JBWMClient * current_client)
+{
+  const uint8_t screens = get_screens(s);
+  const uint32_t generation = header->generation + 1;
+  const Window active = current_client ? current_client->window : 0;
+  struct JBWMClient * c;
+  uint32_t n;
+  uint8_t i;
+  bool changed = header->active != active
+    || header->screen_count != screens;
+  for (i = 0; i < screens; ++i)
+    changed |= header->desktop[i] != s[i].vdesk;
+  for (c = head_client, n = 0; c && n < EXPORT_CAPACITY; c = c->next, ++n) {
+    struct JBWMStateEntry * e = scratch + n;
+    get_entry(e, c, current_client);
+    if (n < header->count && !differ(e, entries + n))
+      e->generation = entries[n].generation;
+    else {
+      e->generation = generation;
+      changed = true;
+    }
+  }
+  if (!changed && n == header->count)
+    return;
+  begin_write();
+  memcpy(entries, scratch, n * sizeof(*entries));
+  header->count = n;
+  header->active = active;
+  header->screen_count = screens;
+  for (i = 0; i < screens; ++i)
+    header->desktop[i] = s[i].vdesk;
+  header->generation = generation;
+  end_write();
+}
+void jbwm_export(struct JBWMScreen * s, struct JBWMClient * head_client,
+  struct JBWMClient * current_client, const int type)
+{
+  if (!header)
+    return;
+  switch (type) {
+  case ConfigureNotify:
+  case CreateNotify:
+  case DestroyNotify:
+  case MapNotify:
+  case UnmapNotify:
+  case ReparentNotify:
+    restack = true;
+  }
+  publish(s, head_client, current_client);
+}
+void jbwm_export_stacking(struct JBWMScreen * s,
+  struct JBWMClient * head_client, struct JBWMClient * current_client)
+{
+  if (!header || !restack)
+    return;
+  query_stacking(s, get_screens(s));
+  publish(s, head_client, current_client);
+}
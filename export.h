@@ -0,0 +1,21 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_EXPORT_H
+#define JBWM_EXPORT_H
+#include <X11/Xlib.h>
+struct JBWMClient;
+struct JBWMScreen;
+/* With -s, publish the clients in /dev/shm/jbwm-DISPLAY, laid out as in
+ * JBWMStateHeader.h and JBWMStateEntry.h, so panels and pagers can read
+ * them without asking the server.  */
+void jbwm_set_up_export(Display * d) __attribute__((nonnull));
+/* Publish the state after handling an event of type, if it changed.
+ * Events that may change the stacking order only mark it stale.  */
+void jbwm_export(struct JBWMScreen * s, struct JBWMClient * head_client,
+  struct JBWMClient * current_client, const int type)
+__attribute__((nonnull(1)));
+/* Query a stale stacking order and publish it.  This is a round trip per
+ * screen, so it is left until no events are waiting.  */
+void jbwm_export_stacking(struct JBWMScreen * s,
+  struct JBWMClient * head_client, struct JBWMClient * current_client)
+__attribute__((nonnull(1)));
+#endif//!JBWM_EXPORT_H
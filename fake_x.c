@@ -0,0 +1,1468 @@
+// Copyright 2020, Alisa Bedard
+// Names the fields of Display, which the fake must fill in.
+#define XLIB_ILLEGAL_ACCESS
+#include "fake_x.h"
+#include <X11/XKBlib.h>
+#include <X11/Xatom.h>
+#include <X11/Xproto.h>
+#include <X11/Xutil.h>
+#include <X11/extensions/shape.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+enum {
+  FAKE_CONNECTIONS = 8,
+  FAKE_ROOT = 0x100, // the first window, the others numbered after it
+  FAKE_RESOURCE = 0x1000000, // the first font, cursor or graphics context
+  FAKE_COLORMAP = 0x20,
+  FAKE_WIDTH = 1920,
+  FAKE_HEIGHT = 1080,
+  FAKE_ASCENT = 11,
+  FAKE_DESCENT = 3,
+  FAKE_CHAR_WIDTH = 7,
+  FAKE_MIN_KEYCODE = 8,
+  FAKE_MAX_KEYCODE = 255,
+  // Major opcodes the fake gives the extensions it knows.
+  FAKE_SHAPE_OPCODE = 129,
+  FAKE_XKB_OPCODE = 130,
+  // The first event and error of SHAPE, none of which are sent.
+  FAKE_SHAPE_EVENT = 64,
+  FAKE_SHAPE_ERROR = 128
+};
+struct Property {
+  struct Property * next;
+  Atom name, type;
+  int format;
+  unsigned long count; // of items
+  unsigned char * data; // items of format 32 stored as long, as in Xlib
+};
+struct FakeWindow {
+  Window id, parent;
+  int x, y;
+  unsigned int width, height, border;
+  bool mapped, override_redirect;
+  struct Connection * owner;
+  long masks[FAKE_CONNECTIONS]; // selected by each connection
+  Window * children; // bottom to top
+  unsigned int child_count, child_capacity;
+  struct Property * properties;
+};
+/* Xlib sends graphics context changes with the next request drawing with
+ * it, so only a change followed by drawing counts.  */
+struct FakeGC {
+  struct _XGC xlib;
+  unsigned long foreground;
+  bool dirty;
+};
+struct Connection {
+  Display xlib; // first, so that a Display is its connection
+  Screen screen;
+  struct FakeGC gc;
+  XEvent * queue; // a ring holding xlib.qlen events
+  unsigned int head, capacity;
+  XErrorEvent * errors; // not yet reported
+  unsigned int error_count;
+  unsigned long requests, round_trips, counts[256];
+  uint8_t index;
+  bool shape_queried;
+};
+static struct Connection * connections[FAKE_CONNECTIONS];
+static struct FakeWindow ** windows; // indexed by id - FAKE_ROOT
+static unsigned int window_count;
+static char ** atom_names; // indexed by atom - XA_LAST_PREDEFINED - 1
+static uint8_t * atom_interned; // one bit for each connection
+static unsigned int atom_count;
+static KeySym keysyms[FAKE_MAX_KEYCODE + 1];
+static XErrorHandler error_handler;
+static XID next_resource = FAKE_RESOURCE;
+static Window focus = PointerRoot;
+static int pointer_x, pointer_y;
+static Visual visual = {.visualid = 0x21, .class = TrueColor,
+  .red_mask = 0xff0000, .green_mask = 0xff00, .blue_mask = 0xff,
+  .bits_per_rgb = 8, .map_entries = 256};
+static char display_name[] = ":fake", vendor[] = "jbwm fake_x";
+static struct Connection * get_connection(Display * d)
+{
+  return (struct Connection *)d;
+}
+void fake_x_reset_counts(Display * d)
+{
+  struct Connection * c = get_connection(d);
+  c->requests = c->round_trips = 0;
+  memset(c->counts, 0, sizeof(c->counts));
+}
+unsigned long fake_x_get_requests(Display * d)
+{
+  return get_connection(d)->requests;
+}
+unsigned long fake_x_get_round_trips(Display * d)
+{
+  return get_connection(d)->round_trips;
+}
+unsigned long fake_x_get_count(Display * d, const uint8_t opcode)
+{
+  return get_connection(d)->counts[opcode];
+}
+static void * allocate(const size_t size)
+{
+  void * p = calloc(1, size ? size : 1);
+  if (!p) {
+    fputs("fake_x: out of memory\n", stderr);
+    abort();
+  }
+  return p;
+}
+static void request(Display * d, const uint8_t opcode)
+{
+  struct Connection * c = get_connection(d);
+  ++c->xlib.request;
+  ++c->requests;
+  ++c->counts[opcode];
+}
+static void fail(Display * d, const uint8_t code, const uint8_t opcode,
+  const XID id)
+{
+  struct Connection * c = get_connection(d);
+  XErrorEvent * e = realloc(c->errors,
+    (c->error_count + 1) * sizeof(*e));
+  if (!e)
+    abort();
+  c->errors = e;
+  e[c->error_count++] = (XErrorEvent){.type = 0, .display = d,
+    .resourceid = id, .serial = c->xlib.request, .error_code = code,
+    .request_code = opcode};
+}
+// Report the errors received, as Xlib does whenever it reads.
+static void report_errors(Display * d)
+{
+  struct Connection * c = get_connection(d);
+  while (c->error_count) {
+    XErrorEvent e = c->errors[0];
+    memmove(c->errors, c->errors + 1, --c->error_count * sizeof(e));
+    if (error_handler)
+      error_handler(d, &e);
+  }
+}
+/* Count a request waiting for its reply.  The errors received before the
+ * reply are reported while waiting.  */
+static void round_trip(Display * d, const uint8_t opcode)
+{
+  report_errors(d);
+  request(d, opcode);
+  ++get_connection(d)->round_trips;
+}
+static XEvent * peek(struct Connection * c, const unsigned int i)
+{
+  return c->queue + (c->head + i) % c->capacity;
+}
+static void enqueue(struct Connection * c, XEvent * ev)
+{
+  if ((unsigned int)c->xlib.qlen == c->capacity) {
+    const unsigned int n = c->capacity ? c->capacity << 1 : 64;
+    XEvent * q = allocate(n * sizeof(*q));
+    unsigned int i;
+    for (i = 0; i < c->capacity; ++i)
+      q[i] = *peek(c, i);
+    free(c->queue);
+    c->queue = q;
+    c->head = 0;
+    c->capacity = n;
+  }
+  ev->xany.display = &c->xlib;
+  ev->xany.serial = c->xlib.request;
+  *peek(c, c->xlib.qlen++) = *ev;
+}
+static void dequeue(struct Connection * c, const unsigned int i,
+  XEvent * ev)
+{
+  unsigned int j;
+  *ev = *peek(c, i);
+  if (!i)
+    c->head = (c->head + 1) % c->capacity;
+  else
+    for (j = i; j + 1 < (unsigned int)c->xlib.qlen; ++j)
+      *peek(c, j) = *peek(c, j + 1);
+  --c->xlib.qlen;
+}
+static struct FakeWindow * find(const Window id)
+{
+  return id >= FAKE_ROOT && id - FAKE_ROOT < window_count
+    ? windows[id - FAKE_ROOT] : NULL;
+}
+// Return window id, or report BadWindow for the request opcode.
+static struct FakeWindow * get(Display * d, const Window id,
+  const uint8_t opcode)
+{
+  struct FakeWindow * w = find(id);
+  if (!w)
+    fail(d, BadWindow, opcode, id);
+  return w;
+}
+static bool is_viewable(struct FakeWindow * w)
+{
+  for (; w; w = find(w->parent))
+    if (!w->mapped)
+      return false;
+  return true;
+}
+// Store the position of w's origin on the root in x and y.
+static void get_origin(struct FakeWindow * w, int * x, int * y)
+{
+  *x = *y = 0;
+  for (; w; w = find(w->parent)) {
+    *x += w->x + (int)w->border;
+    *y += w->y + (int)w->border;
+  }
+}
+static void add_child(struct FakeWindow * p, const Window id,
+  const unsigned int i)
+{
+  if (p->child_count == p->child_capacity) {
+    Window * c;
+    p->child_capacity = p->child_capacity ? p->child_capacity << 1 : 8;
+    c = realloc(p->children, p->child_capacity * sizeof(*c));
+    if (!c)
+      abort();
+    p->children = c;
+  }
+  memmove(p->children + i + 1, p->children + i,
+    (p->child_count++ - i) * sizeof(Window));
+  p->children[i] = id;
+}
+// Remove id from p's children.
+static void remove_child(struct FakeWindow * p, const Window id)
+{
+  unsigned int i;
+  for (i = 0; i < p->child_count && p->children[i] != id; ++i)
+    ;
+  if (i < p->child_count)
+    memmove(p->children + i, p->children + i + 1,
+      (--p->child_count - i) * sizeof(Window));
+}
+/* Send a structure event on w to the connections selecting it on w and
+ * those selecting substructure events on w's parent.  */
+static void notify(struct FakeWindow * w, XEvent * ev)
+{
+  struct FakeWindow * p = find(w->parent);
+  uint8_t i;
+  for (i = 0; i < FAKE_CONNECTIONS; ++i)
+    if (connections[i]) {
+      if (w->masks[i] & StructureNotifyMask) {
+        ev->xany.window = w->id;
+        enqueue(connections[i], ev);
+      }
+      if (p && p->masks[i] & SubstructureNotifyMask) {
+        ev->xany.window = p->id;
+        enqueue(connections[i], ev);
+      }
+    }
+}
+// Send ev to the connections selecting anything in mask on w.
+static void deliver(struct FakeWindow * w, XEvent * ev, const long mask)
+{
+  uint8_t i;
+  for (i = 0; i < FAKE_CONNECTIONS; ++i)
+    if (connections[i] && w->masks[i] & mask)
+      enqueue(connections[i], ev);
+}
+/* Return the connection which redirects requests on p's children, unless
+ * it is d's own.  */
+static struct Connection * get_redirect(struct FakeWindow * p, Display * d)
+{
+  uint8_t i;
+  if (p)
+    for (i = 0; i < FAKE_CONNECTIONS; ++i)
+      if (connections[i] && p->masks[i] & SubstructureRedirectMask)
+        return connections[i] == get_connection(d) ? NULL
+          : connections[i];
+  return NULL;
+}
+static void map(Display * d, struct FakeWindow * w)
+{
+  struct Connection * r;
+  XEvent e;
+  if (w->mapped)
+    return;
+  if (!w->override_redirect && (r = get_redirect(find(w->parent), d))) {
+    e.xmaprequest = (XMapRequestEvent){.type = MapRequest,
+      .parent = w->parent, .window = w->id};
+    enqueue(r, &e);
+    return;
+  }
+  w->mapped = true;
+  e.xmap = (XMapEvent){.type = MapNotify, .window = w->id,
+    .override_redirect = w->override_redirect};
+  notify(w, &e);
+}
+static void unmap(struct FakeWindow * w)
+{
+  XEvent e;
+  if (!w->mapped)
+    return;
+  w->mapped = false;
+  e.xunmap = (XUnmapEvent){.type = UnmapNotify, .window = w->id};
+  notify(w, &e);
+}
+// Move w among its siblings as mode, relative to sibling if not None.
+static void restack(struct FakeWindow * w, const Window sibling,
+  const int mode)
+{
+  struct FakeWindow * p = find(w->parent);
+  unsigned int i;
+  if (!p)
+    return;
+  remove_child(p, w->id);
+  if (sibling) {
+    for (i = 0; i < p->child_count && p->children[i] != sibling; ++i)
+      ;
+    if (i == p->child_count) // no sibling, so leave w where it goes
+      i = mode == Below || mode == BottomIf ? 0 : p->child_count;
+    else if (mode != Below && mode != BottomIf)
+      ++i;
+  } else
+    i = mode == Below || mode == BottomIf ? 0 : p->child_count;
+  add_child(p, w->id, i);
+}
+static void configure(Display * d, struct FakeWindow * w,
+  const unsigned int mask, XWindowChanges * v)
+{
+  struct FakeWindow * p = find(w->parent);
+  struct Connection * r;
+  XEvent e;
+  unsigned int i;
+  if (!w->override_redirect && (r = get_redirect(p, d))) {
+    e.xconfigurerequest = (XConfigureRequestEvent){
+      .type = ConfigureRequest, .parent = w->parent, .window = w->id,
+      .x = mask & CWX ? v->x : w->x, .y = mask & CWY ? v->y : w->y,
+      .width = mask & CWWidth ? v->width : (int)w->width,
+      .height = mask & CWHeight ? v->height : (int)w->height,
+      .border_width = mask & CWBorderWidth ? v->border_width
+        : (int)w->border,
+      .above = mask & CWSibling ? v->sibling : None,
+      .detail = mask & CWStackMode ? v->stack_mode : Above,
+      .value_mask = mask};
+    enqueue(r, &e);
+    return;
+  }
+  if (mask & CWX)
+    w->x = v->x;
+  if (mask & CWY)
+    w->y = v->y;
+  if (mask & CWWidth && v->width > 0)
+    w->width = v->width;
+  if (mask & CWHeight && v->height > 0)
+    w->height = v->height;
+  if (mask & CWBorderWidth)
+    w->border = v->border_width;
+  if (mask & CWStackMode)
+    restack(w, mask & CWSibling ? v->sibling : None, v->stack_mode);
+  e.xconfigure = (XConfigureEvent){.type = ConfigureNotify,
+    .window = w->id, .x = w->x, .y = w->y, .width = w->width,
+    .height = w->height, .border_width = w->border,
+    .override_redirect = w->override_redirect};
+  if (p) {
+    for (i = 0; p->children[i] != w->id; ++i)
+      ;
+    e.xconfigure.above = i ? p->children[i - 1] : None;
+  }
+  notify(w, &e);
+}
+static void free_properties(struct FakeWindow * w)
+{
+  while (w->properties) {
+    struct Property * p = w->properties;
+    w->properties = p->next;
+    free(p->data);
+    free(p);
+  }
+}
+static void destroy(struct FakeWindow * w)
+{
+  struct FakeWindow * p = find(w->parent);
+  XEvent e;
+  while (w->child_count)
+    destroy(find(w->children[w->child_count - 1]));
+  unmap(w);
+  e.xdestroywindow = (XDestroyWindowEvent){.type = DestroyNotify,
+    .window = w->id};
+  notify(w, &e);
+  if (p)
+    remove_child(p, w->id);
+  if (focus == w->id)
+    focus = PointerRoot;
+  windows[w->id - FAKE_ROOT] = NULL;
+  free_properties(w);
+  free(w->children);
+  free(w);
+}
+static struct FakeWindow * create(struct Connection * c,
+  struct FakeWindow * p, const int x, const int y, const unsigned int width,
+  const unsigned int height, const unsigned int border)
+{
+  struct FakeWindow * w = allocate(sizeof(*w)), ** a;
+  a = realloc(windows, (window_count + 1) * sizeof(*a));
+  if (!a)
+    abort();
+  windows = a;
+  windows[window_count] = w;
+  *w = (struct FakeWindow){.id = FAKE_ROOT + window_count++,
+    .parent = p ? p->id : None, .x = x, .y = y, .width = width,
+    .height = height, .border = border, .owner = c};
+  if (p)
+    add_child(p, w->id, p->child_count);
+  return w;
+}
+static void set_mask(Display * d, struct FakeWindow * w, const long mask)
+{
+  const uint8_t n = get_connection(d)->index;
+  uint8_t i;
+  if (mask & SubstructureRedirectMask)
+    for (i = 0; i < FAKE_CONNECTIONS; ++i)
+      if (i != n && w->masks[i] & SubstructureRedirectMask) {
+        fail(d, BadAccess, X_ChangeWindowAttributes, w->id);
+        return;
+      }
+  w->masks[n] = mask;
+}
+Display * XOpenDisplay(const char * name)
+{
+  struct Connection * c;
+  uint8_t i;
+  (void)name;
+  for (i = 0; i < FAKE_CONNECTIONS && connections[i]; ++i)
+    ;
+  if (i == FAKE_CONNECTIONS)
+    return NULL;
+  if (!windows) // the first connection starts the server
+    create(NULL, NULL, 0, 0, FAKE_WIDTH, FAKE_HEIGHT, 0)->mapped = true;
+  connections[i] = c = allocate(sizeof(*c));
+  c->index = i;
+  c->gc.xlib.gid = next_resource++;
+  c->screen = (Screen){.display = &c->xlib, .root = FAKE_ROOT,
+    .width = FAKE_WIDTH, .height = FAKE_HEIGHT, .mwidth = 508,
+    .mheight = 286, .root_depth = 24, .root_visual = &visual,
+    .default_gc = &c->gc.xlib, .cmap = FAKE_COLORMAP,
+    .white_pixel = 0xffffff, .max_maps = 1, .min_maps = 1};
+  c->xlib.fd = -1;
+  c->xlib.proto_major_version = 11;
+  c->xlib.vendor = vendor;
+  c->xlib.display_name = display_name;
+  c->xlib.nscreens = 1;
+  c->xlib.screens = &c->screen;
+  c->xlib.min_keycode = FAKE_MIN_KEYCODE;
+  c->xlib.max_keycode = FAKE_MAX_KEYCODE;
+  return &c->xlib;
+}
+// The windows d created go with it.  Save-sets are not kept.
+int XCloseDisplay(Display * d)
+{
+  struct Connection * c = get_connection(d);
+  unsigned int i;
+  for (i = 0; i < window_count; ++i)
+    if (windows[i])
+      windows[i]->masks[c->index] = 0;
+  for (i = 0; i < window_count; ++i)
+    if (windows[i] && windows[i]->owner == c)
+      destroy(windows[i]);
+  connections[c->index] = NULL;
+  free(c->queue);
+  free(c->errors);
+  free(c);
+  return 0;
+}
+Status XInitThreads(void)
+{
+  return True;
+}
+XErrorHandler XSetErrorHandler(XErrorHandler handler)
+{
+  XErrorHandler old = error_handler;
+  error_handler = handler;
+  return old;
+}
+int XFree(void * data)
+{
+  free(data);
+  return 1;
+}
+int XFlush(Display * d)
+{
+  (void)d;
+  return 1;
+}
+int XSync(Display * d, Bool discard)
+{
+  struct Connection * c = get_connection(d);
+  round_trip(d, X_GetInputFocus);
+  report_errors(d);
+  if (discard)
+    c->xlib.qlen = c->head = 0;
+  return 1;
+}
+int XNoOp(Display * d)
+{
+  request(d, X_NoOperation);
+  return 1;
+}
+int XPending(Display * d)
+{
+  report_errors(d);
+  return d->qlen;
+}
+int XNextEvent(Display * d, XEvent * ev)
+{
+  report_errors(d);
+  if (!d->qlen) {
+    fputs("fake_x: XNextEvent would wait forever\n", stderr);
+    abort();
+  }
+  dequeue(get_connection(d), 0, ev);
+  return 0;
+}
+// Events arrive as they are sent, so every mode sees the same queue.
+int XEventsQueued(Display * d, int mode)
+{
+  (void)mode;
+  report_errors(d);
+  return d->qlen;
+}
+int XPeekEvent(Display * d, XEvent * ev)
+{
+  report_errors(d);
+  if (!d->qlen) {
+    fputs("fake_x: XPeekEvent would wait forever\n", stderr);
+    abort();
+  }
+  *ev = *peek(get_connection(d), 0);
+  return 0;
+}
+// Return the masks selecting events of type.
+static long get_event_mask(const int type)
+{
+  switch (type) {
+  case KeyPress:
+    return KeyPressMask;
+  case KeyRelease:
+    return KeyReleaseMask;
+  case ButtonPress:
+    return ButtonPressMask;
+  case ButtonRelease:
+    return ButtonReleaseMask;
+  case MotionNotify:
+    return PointerMotionMask | ButtonMotionMask | Button1MotionMask
+      | Button2MotionMask | Button3MotionMask;
+  case EnterNotify:
+    return EnterWindowMask;
+  case LeaveNotify:
+    return LeaveWindowMask;
+  case FocusIn:
+  case FocusOut:
+    return FocusChangeMask;
+  case Expose:
+    return ExposureMask;
+  case PropertyNotify:
+    return PropertyChangeMask;
+  case ColormapNotify:
+    return ColormapChangeMask;
+  case CreateNotify:
+    return SubstructureNotifyMask;
+  case ConfigureNotify:
+  case DestroyNotify:
+  case MapNotify:
+  case UnmapNotify:
+  case ReparentNotify:
+  case GravityNotify:
+  case CirculateNotify:
+    return StructureNotifyMask | SubstructureNotifyMask;
+  case MapRequest:
+  case ConfigureRequest:
+  case CirculateRequest:
+    return SubstructureRedirectMask;
+  }
+  return 0;
+}
+int XMaskEvent(Display * d, long mask, XEvent * ev)
+{
+  struct Connection * c = get_connection(d);
+  unsigned int i;
+  report_errors(d);
+  for (i = 0; i < (unsigned int)d->qlen; ++i)
+    if (get_event_mask(peek(c, i)->type) & mask) {
+      dequeue(c, i, ev);
+      return 0;
+    }
+  fputs("fake_x: XMaskEvent would wait forever\n", stderr);
+  abort();
+}
+/* With no mask, the event goes to the window's creator, as the server
+ * sends it.  Propagation is not done.  */
+Status XSendEvent(Display * d, Window w, Bool propagate, long mask,
+  XEvent * ev)
+{
+  struct FakeWindow * fw;
+  XEvent e = *ev;
+  (void)propagate;
+  request(d, X_SendEvent);
+  if (w == PointerWindow || w == InputFocus)
+    w = focus;
+  if (!(fw = get(d, w, X_SendEvent)))
+    return 1;
+  e.xany.send_event = True;
+  if (mask)
+    deliver(fw, &e, mask);
+  else if (fw->owner)
+    enqueue(fw->owner, &e);
+  return 1;
+}
+Window XCreateWindow(Display * d, Window parent, int x, int y,
+  unsigned int width, unsigned int height, unsigned int border, int depth,
+  unsigned int class, Visual * v, unsigned long mask,
+  XSetWindowAttributes * a)
+{
+  struct FakeWindow * p, * w;
+  XEvent e;
+  (void)depth;
+  (void)class;
+  (void)v;
+  request(d, X_CreateWindow);
+  if (!(p = get(d, parent, X_CreateWindow)))
+    return None;
+  w = create(get_connection(d), p, x, y, width, height, border);
+  if (mask & CWOverrideRedirect)
+    w->override_redirect = a->override_redirect;
+  if (mask & CWEventMask)
+    set_mask(d, w, a->event_mask);
+  e.xcreatewindow = (XCreateWindowEvent){.type = CreateNotify,
+    .parent = p->id, .window = w->id, .x = x, .y = y, .width = width,
+    .height = height, .border_width = border,
+    .override_redirect = w->override_redirect};
+  deliver(p, &e, SubstructureNotifyMask);
+  return w->id;
+}
+Window XCreateSimpleWindow(Display * d, Window parent, int x, int y,
+  unsigned int width, unsigned int height, unsigned int border,
+  unsigned long border_pixel, unsigned long background)
+{
+  (void)border_pixel;
+  (void)background;
+  return XCreateWindow(d, parent, x, y, width, height, border,
+    CopyFromParent, CopyFromParent, CopyFromParent, 0, NULL);
+}
+int XDestroyWindow(Display * d, Window w)
+{
+  struct FakeWindow * fw;
+  request(d, X_DestroyWindow);
+  if ((fw = get(d, w, X_DestroyWindow)) && fw->parent)
+    destroy(fw);
+  return 1;
+}
+// A client is only a connection here, so only the window goes.
+int XKillClient(Display * d, XID resource)
+{
+  struct FakeWindow * w;
+  request(d, X_KillClient);
+  if ((w = get(d, resource, X_KillClient)) && w->parent)
+    destroy(w);
+  return 1;
+}
+int XMapWindow(Display * d, Window w)
+{
+  struct FakeWindow * fw;
+  request(d, X_MapWindow);
+  if ((fw = get(d, w, X_MapWindow)))
+    map(d, fw);
+  return 1;
+}
+int XUnmapWindow(Display * d, Window w)
+{
+  struct FakeWindow * fw;
+  request(d, X_UnmapWindow);
+  if ((fw = get(d, w, X_UnmapWindow)))
+    unmap(fw);
+  return 1;
+}
+int XConfigureWindow(Display * d, Window w, unsigned int mask,
+  XWindowChanges * v)
+{
+  struct FakeWindow * fw;
+  request(d, X_ConfigureWindow);
+  if ((fw = get(d, w, X_ConfigureWindow)))
+    configure(d, fw, mask & 0x7f, v);
+  return 1;
+}
+int XMapRaised(Display * d, Window w)
+{
+  XConfigureWindow(d, w, CWStackMode,
+    &(XWindowChanges){.stack_mode = Above});
+  return XMapWindow(d, w);
+}
+int XMoveWindow(Display * d, Window w, int x, int y)
+{
+  return XConfigureWindow(d, w, CWX | CWY,
+    &(XWindowChanges){.x = x, .y = y});
+}
+int XResizeWindow(Display * d, Window w, unsigned int width,
+  unsigned int height)
+{
+  return XConfigureWindow(d, w, CWWidth | CWHeight,
+    &(XWindowChanges){.width = width, .height = height});
+}
+int XMoveResizeWindow(Display * d, Window w, int x, int y,
+  unsigned int width, unsigned int height)
+{
+  return XConfigureWindow(d, w, CWX | CWY | CWWidth | CWHeight,
+    &(XWindowChanges){.x = x, .y = y, .width = width, .height = height});
+}
+int XSetWindowBorderWidth(Display * d, Window w, unsigned int width)
+{
+  return XConfigureWindow(d, w, CWBorderWidth,
+    &(XWindowChanges){.border_width = width});
+}
+int XRaiseWindow(Display * d, Window w)
+{
+  return XConfigureWindow(d, w, CWStackMode,
+    &(XWindowChanges){.stack_mode = Above});
+}
+int XLowerWindow(Display * d, Window w)
+{
+  return XConfigureWindow(d, w, CWStackMode,
+    &(XWindowChanges){.stack_mode = Below});
+}
+int XReparentWindow(Display * d, Window w, Window parent, int x, int y)
+{
+  struct FakeWindow * fw, * old, * p;
+  bool mapped;
+  XEvent e;
+  uint8_t i;
+  request(d, X_ReparentWindow);
+  if (!(fw = get(d, w, X_ReparentWindow))
+    || !(p = get(d, parent, X_ReparentWindow)) || !fw->parent)
+    return 1;
+  mapped = fw->mapped;
+  unmap(fw);
+  old = find(fw->parent);
+  remove_child(old, fw->id);
+  add_child(p, fw->id, p->child_count);
+  fw->parent = p->id;
+  fw->x = x;
+  fw->y = y;
+  e.xreparent = (XReparentEvent){.type = ReparentNotify, .window = fw->id,
+    .parent = p->id, .x = x, .y = y,
+    .override_redirect = fw->override_redirect};
+  for (i = 0; i < FAKE_CONNECTIONS; ++i)
+    if (connections[i]) {
+      if (fw->masks[i] & StructureNotifyMask) {
+        e.xany.window = fw->id;
+        enqueue(connections[i], &e);
+      }
+      if (old->masks[i] & SubstructureNotifyMask) {
+        e.xany.window = old->id;
+        enqueue(connections[i], &e);
+      }
+      if (p != old && p->masks[i] & SubstructureNotifyMask) {
+        e.xany.window = p->id;
+        enqueue(connections[i], &e);
+      }
+    }
+  if (mapped)
+    map(d, fw);
+  return 1;
+}
+Status XQueryTree(Display * d, Window w, Window * root, Window * parent,
+  Window ** children, unsigned int * count)
+{
+  struct FakeWindow * fw;
+  round_trip(d, X_QueryTree);
+  if (!(fw = get(d, w, X_QueryTree))) {
+    report_errors(d);
+    return 0;
+  }
+  *root = FAKE_ROOT;
+  *parent = fw->parent;
+  *count = fw->child_count;
+  *children = NULL;
+  if (fw->child_count) {
+    *children = allocate(fw->child_count * sizeof(Window));
+    memcpy(*children, fw->children, fw->child_count * sizeof(Window));
+  }
+  return 1;
+}
+// Xlib asks for the attributes and the geometry, each a round trip.
+Status XGetWindowAttributes(Display * d, Window w, XWindowAttributes * a)
+{
+  struct Connection * c = get_connection(d);
+  struct FakeWindow * fw;
+  uint8_t i;
+  round_trip(d, X_GetWindowAttributes);
+  if (!(fw = get(d, w, X_GetWindowAttributes))) {
+    report_errors(d);
+    return 0;
+  }
+  round_trip(d, X_GetGeometry);
+  *a = (XWindowAttributes){.x = fw->x, .y = fw->y, .width = fw->width,
+    .height = fw->height, .border_width = fw->border, .depth = 24,
+    .visual = &visual, .root = FAKE_ROOT, .class = InputOutput,
+    .bit_gravity = ForgetGravity, .win_gravity = NorthWestGravity,
+    .colormap = FAKE_COLORMAP, .map_installed = True,
+    .map_state = fw->mapped ? is_viewable(fw) ? IsViewable : IsUnviewable
+      : IsUnmapped, .your_event_mask = fw->masks[c->index],
+    .override_redirect = fw->override_redirect, .screen = &c->screen};
+  for (i = 0; i < FAKE_CONNECTIONS; ++i)
+    a->all_event_masks |= fw->masks[i];
+  return 1;
+}
+int XChangeWindowAttributes(Display * d, Window w, unsigned long mask,
+  XSetWindowAttributes * a)
+{
+  struct FakeWindow * fw;
+  request(d, X_ChangeWindowAttributes);
+  if (!(fw = get(d, w, X_ChangeWindowAttributes)))
+    return 1;
+  if (mask & CWOverrideRedirect)
+    fw->override_redirect = a->override_redirect;
+  if (mask & CWEventMask)
+    set_mask(d, fw, a->event_mask);
+  return 1;
+}
+int XSelectInput(Display * d, Window w, long mask)
+{
+  return XChangeWindowAttributes(d, w, CWEventMask,
+    &(XSetWindowAttributes){.event_mask = mask});
+}
+int XSetWindowBorder(Display * d, Window w, unsigned long pixel)
+{
+  return XChangeWindowAttributes(d, w, CWBorderPixel,
+    &(XSetWindowAttributes){.border_pixel = pixel});
+}
+int XAddToSaveSet(Display * d, Window w)
+{
+  (void)w;
+  request(d, X_ChangeSaveSet);
+  return 1;
+}
+int XRemoveFromSaveSet(Display * d, Window w)
+{
+  (void)w;
+  request(d, X_ChangeSaveSet);
+  return 1;
+}
+/* Atoms are interned once for each connection, as Xlib keeps those it
+ * has.  The predefined atoms are not named here, as jbwm uses them by
+ * their constants.  */
+static Atom intern(Display * d, const char * name, const bool create)
+{
+  const uint8_t bit = 1 << get_connection(d)->index;
+  unsigned int i;
+  for (i = 0; i < atom_count && strcmp(atom_names[i], name); ++i)
+    ;
+  if (i < atom_count && atom_interned[i] & bit)
+    return XA_LAST_PREDEFINED + 1 + i;
+  request(d, X_InternAtom);
+  if (i == atom_count) {
+    char ** n;
+    uint8_t * b;
+    if (!create)
+      return None;
+    n = realloc(atom_names, (atom_count + 1) * sizeof(*n));
+    b = realloc(atom_interned, atom_count + 1);
+    if (!n || !b)
+      abort();
+    atom_names = n;
+    atom_interned = b;
+    atom_names[i] = strcpy(allocate(strlen(name) + 1), name);
+    atom_interned[i] = 0;
+    ++atom_count;
+  }
+  atom_interned[i] |= bit;
+  return XA_LAST_PREDEFINED + 1 + i;
+}
+Atom XInternAtom(Display * d, const char * name, Bool only_if_exists)
+{
+  const unsigned long sent = get_connection(d)->requests;
+  const Atom a = intern(d, name, !only_if_exists);
+  if (get_connection(d)->requests != sent)
+    ++get_connection(d)->round_trips;
+  return a;
+}
+// The requests missing from the cache are sent, then all replies read.
+Status XInternAtoms(Display * d, char ** names, int count,
+  Bool only_if_exists, Atom * atoms)
+{
+  const unsigned long sent = get_connection(d)->requests;
+  Status found = 1;
+  int i;
+  for (i = 0; i < count; ++i)
+    if (!(atoms[i] = intern(d, names[i], !only_if_exists)))
+      found = 0;
+  if (get_connection(d)->requests != sent)
+    ++get_connection(d)->round_trips;
+  return found;
+}
+// Predefined atoms are only named by their number.
+char * XGetAtomName(Display * d, Atom atom)
+{
+  char * name;
+  round_trip(d, X_GetAtomName);
+  if (!atom || atom > XA_LAST_PREDEFINED + atom_count) {
+    fail(d, BadAtom, X_GetAtomName, atom);
+    report_errors(d);
+    return NULL;
+  }
+  if (atom > XA_LAST_PREDEFINED)
+    return strcpy(allocate(strlen(atom_names[atom - XA_LAST_PREDEFINED - 1])
+        + 1), atom_names[atom - XA_LAST_PREDEFINED - 1]);
+  name = allocate(sizeof("ATOM_") + 3);
+  sprintf(name, "ATOM_%u", (unsigned int)atom);
+  return name;
+}
+static struct Property ** find_property(struct FakeWindow * w,
+  const Atom name)
+{
+  struct Property ** p;
+  for (p = &w->properties; *p && (*p)->name != name; p = &(*p)->next)
+    ;
+  return p;
+}
+static size_t get_unit(const int format)
+{
+  return format == 32 ? sizeof(long) : (size_t)format >> 3;
+}
+static void notify_property(struct FakeWindow * w, const Atom name,
+  const int state)
+{
+  XEvent e;
+  e.xproperty = (XPropertyEvent){.type = PropertyNotify, .window = w->id,
+    .atom = name, .time = CurrentTime, .state = state};
+  deliver(w, &e, PropertyChangeMask);
+}
+int XChangeProperty(Display * d, Window w, Atom name, Atom type,
+  int format, int mode, const unsigned char * data, int count)
+{
+  struct FakeWindow * fw;
+  struct Property ** pp, * p;
+  size_t unit;
+  unsigned char * n;
+  request(d, X_ChangeProperty);
+  if (!(fw = get(d, w, X_ChangeProperty)))
+    return 1;
+  if ((format != 8 && format != 16 && format != 32) || count < 0) {
+    fail(d, BadValue, X_ChangeProperty, w);
+    return 1;
+  }
+  unit = get_unit(format);
+  pp = find_property(fw, name);
+  if (!(p = *pp) || mode == PropModeReplace) {
+    if (!p) {
+      *pp = p = allocate(sizeof(*p));
+      p->name = name;
+    }
+    free(p->data);
+    p->data = NULL;
+    p->count = 0;
+    p->type = type;
+    p->format = format;
+  } else if (p->type != type || p->format != format) {
+    fail(d, BadMatch, X_ChangeProperty, w);
+    return 1;
+  }
+  n = allocate((p->count + count) * unit);
+  if (p->count)
+    memcpy(n + (mode == PropModePrepend ? count * unit : 0), p->data,
+      p->count * unit);
+  if (count)
+    memcpy(n + (mode == PropModePrepend ? 0 : p->count * unit), data,
+      count * unit);
+  free(p->data);
+  p->data = n;
+  p->count += count;
+  notify_property(fw, name, PropertyNewValue);
+  return 1;
+}
+static void delete_property(struct FakeWindow * w, struct Property ** pp)
+{
+  struct Property * p = *pp;
+  const Atom name = p->name;
+  *pp = p->next;
+  free(p->data);
+  free(p);
+  notify_property(w, name, PropertyDelete);
+}
+int XDeleteProperty(Display * d, Window w, Atom name)
+{
+  struct FakeWindow * fw;
+  struct Property ** pp;
+  request(d, X_DeleteProperty);
+  if ((fw = get(d, w, X_DeleteProperty)) && *(pp = find_property(fw, name)))
+    delete_property(fw, pp);
+  return 1;
+}
+int XGetWindowProperty(Display * d, Window w, Atom name, long offset,
+  long length, Bool delete, Atom type, Atom * actual_type,
+  int * actual_format, unsigned long * count, unsigned long * after,
+  unsigned char ** data)
+{
+  struct FakeWindow * fw;
+  struct Property ** pp, * p;
+  unsigned long size, start, bytes;
+  size_t unit, item;
+  round_trip(d, X_GetProperty);
+  *actual_type = None;
+  *actual_format = 0;
+  *count = *after = 0;
+  *data = NULL;
+  if (!(fw = get(d, w, X_GetProperty))) {
+    report_errors(d);
+    return BadWindow;
+  }
+  if (!(p = *(pp = find_property(fw, name))))
+    return Success;
+  *actual_type = p->type;
+  *actual_format = p->format;
+  item = p->format >> 3;
+  size = p->count * item;
+  if (type != AnyPropertyType && type != p->type) {
+    *after = size;
+    return Success;
+  }
+  start = 4 * (unsigned long)offset;
+  if (offset < 0 || length < 0 || start > size) {
+    fail(d, BadValue, X_GetProperty, w);
+    report_errors(d);
+    return BadValue;
+  }
+  bytes = size - start;
+  if ((unsigned long)length <= bytes / 4)
+    bytes = 4 * (unsigned long)length;
+  unit = get_unit(p->format);
+  *count = bytes / item;
+  *after = size - start - bytes;
+  // Xlib ends the data with a zero, so strings may be used as they are.
+  *data = allocate(*count * unit + 1);
+  memcpy(*data, p->data + start / item * unit, *count * unit);
+  if (delete && !*after)
+    delete_property(fw, pp);
+  return Success;
+}
+Status XGetWMNormalHints(Display * d, Window w, XSizeHints * h,
+  long * supplied)
+{
+  Atom type;
+  int format;
+  unsigned long n, after;
+  unsigned char * data;
+  long * l;
+  if (XGetWindowProperty(d, w, XA_WM_NORMAL_HINTS, 0, 18, False,
+      XA_WM_SIZE_HINTS, &type, &format, &n, &after, &data) != Success
+    || type != XA_WM_SIZE_HINTS || format != 32 || n < 15) {
+    XFree(data);
+    return 0;
+  }
+  l = (long *)(void *)data;
+  *h = (XSizeHints){.flags = l[0], .x = l[1], .y = l[2], .width = l[3],
+    .height = l[4], .min_width = l[5], .min_height = l[6],
+    .max_width = l[7], .max_height = l[8], .width_inc = l[9],
+    .height_inc = l[10], .min_aspect = {l[11], l[12]},
+    .max_aspect = {l[13], l[14]}};
+  *supplied = USPosition | USSize | PAllHints;
+  if (n >= 18) {
+    h->base_width = l[15];
+    h->base_height = l[16];
+    h->win_gravity = l[17];
+    *supplied |= PBaseSize | PWinGravity;
+  } else
+    h->flags &= ~(PBaseSize | PWinGravity);
+  XFree(data);
+  return 1;
+}
+Status XGetWMProtocols(Display * d, Window w, Atom ** protocols,
+  int * count)
+{
+  Atom type;
+  int format;
+  unsigned long n, after;
+  unsigned char * data;
+  if (XGetWindowProperty(d, w, XInternAtom(d, "WM_PROTOCOLS", False), 0,
+      1000000, False, XA_ATOM, &type, &format, &n, &after, &data)
+    != Success || type != XA_ATOM || format != 32) {
+    XFree(data);
+    return 0;
+  }
+  *protocols = (Atom *)(void *)data;
+  *count = n;
+  return 1;
+}
+int XSetInputFocus(Display * d, Window w, int revert_to, Time t)
+{
+  (void)revert_to;
+  (void)t;
+  request(d, X_SetInputFocus);
+  focus = w;
+  return 1;
+}
+// The pointer is only a position.  No crossing events are sent.
+Bool XQueryPointer(Display * d, Window w, Window * root, Window * child,
+  int * root_x, int * root_y, int * x, int * y, unsigned int * mask)
+{
+  struct FakeWindow * fw, * r = find(FAKE_ROOT);
+  unsigned int i;
+  round_trip(d, X_QueryPointer);
+  if (!(fw = get(d, w, X_QueryPointer))) {
+    report_errors(d);
+    return False;
+  }
+  *root = FAKE_ROOT;
+  *child = None;
+  for (i = r->child_count; i--;) {
+    struct FakeWindow * c = find(r->children[i]);
+    if (c->mapped && pointer_x >= c->x && pointer_y >= c->y
+      && pointer_x < c->x + (int)(c->width + 2 * c->border)
+      && pointer_y < c->y + (int)(c->height + 2 * c->border)) {
+      *child = c->id;
+      break;
+    }
+  }
+  *root_x = pointer_x;
+  *root_y = pointer_y;
+  get_origin(fw, x, y);
+  *x = pointer_x - *x;
+  *y = pointer_y - *y;
+  *mask = 0;
+  return True;
+}
+int XWarpPointer(Display * d, Window src, Window dest, int src_x,
+  int src_y, unsigned int src_width, unsigned int src_height, int x, int y)
+{
+  struct FakeWindow * w;
+  (void)src;
+  (void)src_x;
+  (void)src_y;
+  (void)src_width;
+  (void)src_height;
+  request(d, X_WarpPointer);
+  if (dest && (w = get(d, dest, X_WarpPointer))) {
+    get_origin(w, &pointer_x, &pointer_y);
+    pointer_x += x;
+    pointer_y += y;
+  } else if (!dest) {
+    pointer_x += x;
+    pointer_y += y;
+  }
+  return 1;
+}
+int XGrabKey(Display * d, int key, unsigned int modifiers, Window w,
+  Bool owner_events, int pointer_mode, int keyboard_mode)
+{
+  (void)key;
+  (void)modifiers;
+  (void)w;
+  (void)owner_events;
+  (void)pointer_mode;
+  (void)keyboard_mode;
+  request(d, X_GrabKey);
+  return 1;
+}
+int XUngrabKey(Display * d, int key, unsigned int modifiers, Window w)
+{
+  (void)key;
+  (void)modifiers;
+  (void)w;
+  request(d, X_UngrabKey);
+  return 1;
+}
+int XGrabButton(Display * d, unsigned int button, unsigned int modifiers,
+  Window w, Bool owner_events, unsigned int mask, int pointer_mode,
+  int keyboard_mode, Window confine_to, Cursor cursor)
+{
+  (void)button;
+  (void)modifiers;
+  (void)w;
+  (void)owner_events;
+  (void)mask;
+  (void)pointer_mode;
+  (void)keyboard_mode;
+  (void)confine_to;
+  (void)cursor;
+  request(d, X_GrabButton);
+  return 1;
+}
+int XGrabKeyboard(Display * d, Window w, Bool owner_events,
+  int pointer_mode, int keyboard_mode, Time t)
+{
+  (void)w;
+  (void)owner_events;
+  (void)pointer_mode;
+  (void)keyboard_mode;
+  (void)t;
+  round_trip(d, X_GrabKeyboard);
+  return GrabSuccess;
+}
+int XUngrabKeyboard(Display * d, Time t)
+{
+  (void)t;
+  request(d, X_UngrabKeyboard);
+  return 1;
+}
+int XGrabPointer(Display * d, Window w, Bool owner_events,
+  unsigned int mask, int pointer_mode, int keyboard_mode, Window confine_to,
+  Cursor cursor, Time t)
+{
+  (void)w;
+  (void)owner_events;
+  (void)mask;
+  (void)pointer_mode;
+  (void)keyboard_mode;
+  (void)confine_to;
+  (void)cursor;
+  (void)t;
+  round_trip(d, X_GrabPointer);
+  return GrabSuccess;
+}
+int XUngrabPointer(Display * d, Time t)
+{
+  (void)t;
+  request(d, X_UngrabPointer);
+  return 1;
+}
+int XGrabServer(Display * d)
+{
+  request(d, X_GrabServer);
+  return 1;
+}
+int XUngrabServer(Display * d)
+{
+  request(d, X_UngrabServer);
+  return 1;
+}
+XModifierKeymap * XGetModifierMapping(Display * d)
+{
+  XModifierKeymap * m = allocate(sizeof(*m));
+  round_trip(d, X_GetModifierMapping);
+  m->max_keypermod = 1;
+  m->modifiermap = allocate(8);
+  return m;
+}
+int XFreeModifiermap(XModifierKeymap * m)
+{
+  if (m)
+    free(m->modifiermap);
+  free(m);
+  return 1;
+}
+// Give each keysym asked for a keycode of its own.
+KeyCode XKeysymToKeycode(Display * d, KeySym k)
+{
+  unsigned int i;
+  (void)d;
+  if (k == NoSymbol)
+    return 0;
+  for (i = FAKE_MIN_KEYCODE; i <= FAKE_MAX_KEYCODE && keysyms[i] != k
+    && keysyms[i] != NoSymbol; ++i)
+    ;
+  if (i > FAKE_MAX_KEYCODE)
+    return 0;
+  keysyms[i] = k;
+  return i;
+}
+KeySym XkbKeycodeToKeysym(Display * d, KeyCode k, int group, int level)
+{
+  (void)d;
+  (void)group;
+  return level ? NoSymbol : keysyms[k];
+}
+Bool XkbSetDetectableAutoRepeat(Display * d, Bool detectable,
+  Bool * supported)
+{
+  (void)detectable;
+  round_trip(d, FAKE_XKB_OPCODE);
+  if (supported)
+    *supported = True;
+  return True;
+}
+// No key is ever held down.
+Status XkbGetState(Display * d, unsigned int device, XkbStatePtr state)
+{
+  (void)device;
+  round_trip(d, FAKE_XKB_OPCODE);
+  memset(state, 0, sizeof(*state));
+  return Success;
+}
+int XRefreshKeyboardMapping(XMappingEvent * e)
+{
+  (void)e;
+  return 0;
+}
+XFontStruct * XLoadQueryFont(Display * d, const char * name)
+{
+  XFontStruct * f = allocate(sizeof(*f));
+  (void)name;
+  request(d, X_OpenFont);
+  round_trip(d, X_QueryFont);
+  f->fid = next_resource++;
+  f->ascent = f->max_bounds.ascent = FAKE_ASCENT;
+  f->descent = f->max_bounds.descent = FAKE_DESCENT;
+  f->max_bounds.width = f->min_bounds.width = FAKE_CHAR_WIDTH;
+  return f;
+}
+int XTextWidth(XFontStruct * f, const char * s, int count)
+{
+  (void)s;
+  return count * f->max_bounds.width;
+}
+Cursor XCreateFontCursor(Display * d, unsigned int shape)
+{
+  (void)shape;
+  request(d, X_CreateGlyphCursor);
+  return next_resource++;
+}
+Status XAllocNamedColor(Display * d, Colormap cmap, const char * name,
+  XColor * screen, XColor * exact)
+{
+  unsigned long pixel = 0;
+  (void)cmap;
+  round_trip(d, X_AllocNamedColor);
+  for (; *name; ++name)
+    pixel = pixel * 31 + (unsigned char)*name;
+  pixel &= 0xffffff;
+  *screen = (XColor){.pixel = pixel, .red = (pixel >> 16) * 0x101,
+    .green = (pixel >> 8 & 0xff) * 0x101, .blue = (pixel & 0xff) * 0x101,
+    .flags = DoRed | DoGreen | DoBlue};
+  *exact = *screen;
+  return 1;
+}
+int XInstallColormap(Display * d, Colormap cmap)
+{
+  (void)cmap;
+  request(d, X_InstallColormap);
+  return 1;
+}
+int XChangeGC(Display * d, GC gc, unsigned long mask, XGCValues * v)
+{
+  struct FakeGC * g = (struct FakeGC *)gc;
+  if (mask & GCForeground)
+    g->foreground = v->foreground;
+  if (mask) {
+    request(d, X_ChangeGC);
+    g->dirty = false;
+  }
+  return 1;
+}
+int XSetForeground(Display * d, GC gc, unsigned long pixel)
+{
+  struct FakeGC * g = (struct FakeGC *)gc;
+  (void)d;
+  if (g->foreground != pixel) {
+    g->foreground = pixel;
+    g->dirty = true;
+  }
+  return 1;
+}
+static void flush_gc(Display * d, GC gc)
+{
+  struct FakeGC * g = (struct FakeGC *)gc;
+  if (g->dirty) {
+    request(d, X_ChangeGC);
+    g->dirty = false;
+  }
+}
+int XDrawString(Display * d, Drawable w, GC gc, int x, int y,
+  const char * s, int length)
+{
+  (void)w;
+  (void)x;
+  (void)y;
+  (void)s;
+  (void)length;
+  flush_gc(d, gc);
+  request(d, X_PolyText8);
+  return 1;
+}
+int XFillRectangle(Display * d, Drawable w, GC gc, int x, int y,
+  unsigned int width, unsigned int height)
+{
+  (void)w;
+  (void)x;
+  (void)y;
+  (void)width;
+  (void)height;
+  flush_gc(d, gc);
+  request(d, X_PolyFillRectangle);
+  return 1;
+}
+int XClearWindow(Display * d, Window w)
+{
+  (void)w;
+  request(d, X_ClearArea);
+  return 1;
+}
+// Every window stays rectangular, so SHAPE only answers with the size.
+Bool XShapeQueryExtension(Display * d, int * event, int * error)
+{
+  struct Connection * c = get_connection(d);
+  if (!c->shape_queried) {
+    round_trip(d, X_QueryExtension);
+    c->shape_queried = true;
+  }
+  *event = FAKE_SHAPE_EVENT;
+  *error = FAKE_SHAPE_ERROR;
+  return True;
+}
+Status XShapeQueryExtents(Display * d, Window w, Bool * bounding_shaped,
+  int * x, int * y, unsigned int * width, unsigned int * height,
+  Bool * clip_shaped, int * clip_x, int * clip_y, unsigned int * clip_width,
+  unsigned int * clip_height)
+{
+  struct FakeWindow * fw;
+  round_trip(d, FAKE_SHAPE_OPCODE);
+  if (!(fw = get(d, w, FAKE_SHAPE_OPCODE))) {
+    report_errors(d);
+    return 0;
+  }
+  *bounding_shaped = *clip_shaped = False;
+  *x = *y = *clip_x = *clip_y = 0;
+  *width = *clip_width = fw->width;
+  *height = *clip_height = fw->height;
+  return 1;
+}
+void XShapeSelectInput(Display * d, Window w, unsigned long mask)
+{
+  (void)w;
+  (void)mask;
+  request(d, FAKE_SHAPE_OPCODE);
+}
+void XShapeCombineRectangles(Display * d, Window w, int kind, int x, int y,
+  XRectangle * r, int count, int op, int ordering)
+{
+  (void)w;
+  (void)kind;
+  (void)x;
+  (void)y;
+  (void)r;
+  (void)count;
+  (void)op;
+  (void)ordering;
+  request(d, FAKE_SHAPE_OPCODE);
+}
+void XShapeCombineMask(Display * d, Window w, int kind, int x, int y,
+  Pixmap src, int op)
+{
+  (void)w;
+  (void)kind;
+  (void)x;
+  (void)y;
+  (void)src;
+  (void)op;
+  request(d, FAKE_SHAPE_OPCODE);
+}
+void XShapeCombineShape(Display * d, Window w, int kind, int x, int y,
+  Window src, int src_kind, int op)
+{
+  (void)w;
+  (void)kind;
+  (void)x;
+  (void)y;
+  (void)src;
+  (void)src_kind;
+  (void)op;
+  request(d, FAKE_SHAPE_OPCODE);
+}
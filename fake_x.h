@@ -0,0 +1,26 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_FAKE_X_H
+#define JBWM_FAKE_X_H
+/* fake_x.c is an X server in memory, linked in place of Xlib, so the
+ * window manager runs unchanged without a display.  It keeps one screen
+ * of windows with their geometry, stacking, mapping, event masks and
+ * properties, and queues the events a server would send each
+ * connection, redirecting MapWindow and ConfigureWindow from other
+ * clients to the one selecting SubstructureRedirectMask.  Grabs,
+ * drawing, fonts, colors and the keyboard are only counted.  Errors are
+ * reported to the error handler when the connection next reads.
+ *
+ * Every request each connection sends is counted, by its major opcode,
+ * as are the round trips among them.  */
+#include <X11/Xlib.h>
+#include <stdint.h>
+// Start counting d's requests and round trips again from zero.
+void fake_x_reset_counts(Display * d) __attribute__((nonnull));
+// Return the requests d sent since its counts were reset.
+unsigned long fake_x_get_requests(Display * d) __attribute__((nonnull));
+// Return how many of those requests waited for a reply.
+unsigned long fake_x_get_round_trips(Display * d) __attribute__((nonnull));
+// Return how many of those requests had the major opcode given.
+unsigned long fake_x_get_count(Display * d, const uint8_t opcode)
+__attribute__((nonnull));
+#endif//!JBWM_FAKE_X_H
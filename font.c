@@ -4,6 +4,7 @@
 #include <X11/Xft/Xft.h>
 #endif//JBWM_USE_XFT
 #include "config.h"
+#include <pthread.h>
 #include <stdbool.h>
 #include "util.h"
 static struct JBWMFont {
@@ -14,11 +15,30 @@ static struct JBWMFont {
 #endif//JBWM_USE_XFT
   short ascent,descent,height;
 } jbwm_font;
+#ifdef JBWM_USE_XFT
+static pthread_t preload;
+static bool preloading;
+static void * load_config(void * arg __attribute__((unused)))
+{
+  FcInit(); // Reads the configuration and caches, the slow part.
+  return NULL;
+}
+#endif//JBWM_USE_XFT
+void jbwm_preload_font(void)
+{
+#ifdef JBWM_USE_XFT
+  preloading = !pthread_create(&preload, NULL, load_config, NULL);
+#endif//JBWM_USE_XFT
+}
 void jbwm_open_font(Display * d)
 {
   static bool already_created;
   if(!already_created){
 #ifdef JBWM_USE_XFT
+    if (preloading) {
+      pthread_join(preload, NULL);
+      preloading = false;
+    }
     jbwm_font.font = XftFontOpenName(d, DefaultScreen(d), JBWM_FONT);
 #else//!JBWM_USE_XFT
     jbwm_font.font = XLoadQueryFont(d, JBWM_FONT);
@@ -6,5 +6,8 @@
 void * jbwm_get_font(void);
 uint8_t jbwm_get_font_ascent(void);
 uint8_t jbwm_get_font_height(void);
+/* Start loading the font configuration on a thread of its own, so it
+ * overlaps opening the display.  jbwm_open_font waits for it.  */
+void jbwm_preload_font(void);
 void jbwm_open_font(Display * d);
 #endif//JBWM_FONT_H
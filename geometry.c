@@ -2,31 +2,9 @@
 #include "geometry.h"
 #include "JBWMClient.h"
 #include "JBWMScreen.h"
-#include "JBWMSize.h"
 #include "log.h"
 #include "macros.h"
-#include <X11/Xutil.h>
-struct GeometryData {
-  Display * display;
-  union JBWMRectangle * attribute;
-  union JBWMRectangle * geometry;
-  Window window;
-};
-static long handle_wm_normal_hints(struct GeometryData * g)
-{
-  /* Though these statements may be combined, writing the following
-   * assignment this way ensures the conditional is only evaluated once.
-   * */
-  XSizeHints h;
-  if (XGetWMNormalHints(g->display, g->window, &h, &(long){0})
-    && (h.flags & USSize)) {
-    // if size hints provided, use them
-    g->geometry->width = JB_MAX(h.width, h.min_width);
-    g->geometry->height = JB_MAX(h.height, h.min_height);
-  } else // use existing window attributes
-    *g->geometry = *g->attribute;
-  return h.flags;
-}
+#include "size_hints.h"
 static void check_dimensions(union JBWMRectangle * g,
   const struct JBWMSize screen)
 {
@@ -45,6 +23,29 @@ static void center(union JBWMRectangle * g,
   g->x = get_center(g->width, s.width);
   g->y = get_center(g->height, s.height);
 }
+bool jbwm_get_initial_geometry(union JBWMRectangle * g,
+  const union JBWMRectangle * attribute, const XSizeHints * h,
+  const struct JBWMSize screen)
+{
+  if (h->flags & USSize) {
+    // if size hints provided, use them
+    g->width = JB_MAX(h->width, h->min_width);
+    g->height = JB_MAX(h->height, h->min_height);
+  } else { // use existing window attributes
+    g->width = attribute->width;
+    g->height = attribute->height;
+  }
+  check_dimensions(g, screen);
+  if ((h->flags & USPosition) && (attribute->x || attribute->y)) {
+    JBWM_LOG("\t\tPosition is set by hints.");
+    g->x = attribute->x;
+    g->y = attribute->y;
+    return true;
+  }
+  // Position not specified
+  center(g, screen);
+  return false;
+}
 // returns true if window is viewable
 static bool get_window_attributes(struct JBWMClient * c,
   union JBWMRectangle * geometry_attribute)
@@ -60,29 +61,18 @@ static bool get_window_attributes(struct JBWMClient * c,
     .width = a.width, .height = a.height};
   return a.map_state == IsViewable;
 }
-static void init_geometry_for_screen(struct JBWMClient * c,
-  union JBWMRectangle * geometry_attribute)
+static bool init_geometry_for_screen(struct JBWMClient * c,
+  const union JBWMRectangle * geometry_attribute)
 {
   struct JBWMScreen *s=c->screen;
-  Display * d = c->screen->xlib->display;
-  struct JBWMSize screen_size={s->xlib->width,s->xlib->height};
-  struct GeometryData g={ .display=d, .attribute = geometry_attribute,
-    .geometry = &c->size, .window = c->window};
-  check_dimensions(g.geometry, screen_size);
-  {
-    const long flags = handle_wm_normal_hints(&g);
-    const bool user_specified_position = flags & USPosition;
-    const bool nonzero_position = g.attribute->x ||
-    g.attribute->y;
-    if (user_specified_position && nonzero_position) {
-      JBWM_LOG("\t\tPosition is set by hints.");
-      g.geometry->x = g.attribute->x;
-      g.geometry->y = g.attribute->y;
-    } else // Position not specified
-      center(g.geometry, screen_size);
-  }
+  XSizeHints h;
+  if (!XGetWMNormalHints(s->xlib->display, c->window, &h, &(long){0}))
+    h.flags = 0;
+  jbwm_set_size_hints(c, &h); // Saves reading them again to resize.
+  return jbwm_get_initial_geometry(&c->size, geometry_attribute, &h,
+    (struct JBWMSize){s->xlib->width, s->xlib->height});
 }
-void jbwm_set_client_geometry(struct JBWMClient * c)
+bool jbwm_set_client_geometry(struct JBWMClient * c)
 {
   union JBWMRectangle geometry_attribute;
   if (get_window_attributes(c, &geometry_attribute)) { // viewable
@@ -91,6 +81,7 @@ void jbwm_set_client_geometry(struct JBWMClient * c)
     /* If the window is already on screen before the window
        manager starts, simply save its geometry then return. */
     c->size = geometry_attribute;
-  } else // not viewable yet
-    init_geometry_for_screen(c, &geometry_attribute);
+    return true;
+  } // not viewable yet
+  return init_geometry_for_screen(c, &geometry_attribute);
 }
@@ -1,11 +1,22 @@
 // Copyright 2020, Alisa Bedard
 #ifndef JBWM_GEOMETRY_H
 #define JBWM_GEOMETRY_H
+#include <stdbool.h>
 #include <stdint.h>
 #include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include "JBWMRectangle.h"
 #include "JBWMSize.h"
 struct JBWMClient;
 //struct JBWMSize jbwm_get_display_size(Display * d,
 //    const uint8_t screen) __attribute__((pure));
-void jbwm_set_client_geometry(struct JBWMClient * c);
+/* Decide where a new window goes from its attributes and size hints.
+ * This only computes, so placement can be exercised without a server.
+ * Return true if the hints position it, else it is centred on screen.  */
+bool jbwm_get_initial_geometry(union JBWMRectangle * g,
+  const union JBWMRectangle * attribute, const XSizeHints * h,
+  const struct JBWMSize screen) __attribute__((nonnull));
+/* Set the initial geometry of c.  Return false if c has no position of
+ * its own, so is for jbwm_place_client to place.  */
+bool jbwm_set_client_geometry(struct JBWMClient * c);
 #endif//!JBWM_GEOMETRY_H
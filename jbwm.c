@@ -8,10 +8,16 @@
 #include "ewmh.h"
 #include "font.h"
 #include "atom.h"
+#include "client.h"
 #include "JBWMScreen.h"
 #include "keys.h"
 #include "log.h"
+#include "monitor.h"
 #include "new.h"
+#include "screen.h"
+#include "restart.h"
+#include "startup.h"
+#include <pthread.h>
 #include <stdbool.h>
 #include "util.h"
 #include "vdesk.h"
@@ -23,10 +29,22 @@ static void allocate_xft_color(Display * d, struct JBWMScreen * s)
     &s->font_color);
 }
 #endif//JBWM_USE_XFT
-static void allocate_colors(struct JBWMScreen * s)
+/* Screens sharing a colormap share their pixels, so only the first of
+ * them looks the colors up.  first is the first screen.  */
+static void allocate_colors(struct JBWMScreen * s,
+  struct JBWMScreen * first)
 {
   Display * d=s->xlib->display;
   const uint8_t n = s->id;
+  for (; first < s; ++first)
+    if (DefaultColormapOfScreen(first->xlib)
+      == DefaultColormapOfScreen(s->xlib)) {
+      s->pixels = first->pixels;
+#ifdef JBWM_USE_XFT
+      s->font_color = first->font_color;
+#endif//JBWM_USE_XFT
+      return;
+    }
 #define PIX(field, color) s->pixels.field = jbwm_get_pixel(d, n, color);
   PIX(bg, JBWM_BG);
   PIX(fc, JBWM_FC);
@@ -43,7 +61,8 @@ static void allocate_colors(struct JBWMScreen * s)
 static bool check_redirect(Display * d, const Window w)
 {
   XWindowAttributes a;
-  XGetWindowAttributes(d, w, &a);
+  if (!XGetWindowAttributes(d, w, &a))
+    return false; // Destroyed since it was listed.
   JBWM_LOG("check_redirect(0x%x): override_redirect: %s, "
     "map_state: %s", (int)w,
     a.override_redirect ? "true" : "false",
@@ -57,23 +76,13 @@ static Window * get_windows(Display * dpy, const Window root,
 {
   Window * w, d;
   unsigned int n;
-  XQueryTree(dpy, root, &d, &d, &w, &n);
+  if (!XQueryTree(dpy, root, &d, &d, &w, &n)) {
+    w = NULL;
+    n = 0;
+  }
   *win_count = n;
   return w;
 }
-static void setup_clients(Display * d, struct JBWMScreen * s,
-  struct JBWMClient ** head_client, struct JBWMClient ** current_client)
-{
-  uint16_t n;
-  Window * w = get_windows(d, RootWindow(d, s->id), &n);
-  JBWM_LOG("Started with %d clients", n);
-  if (w) { // Avoid segmentation fault on empty list.
-    while(n--)
-      if(check_redirect(d,w[n]))
-        jbwm_new_client(s, head_client, current_client, w[n]);
-    XFree(w);
-  }
-}
 static inline void setup_gc(Display * d, struct JBWMScreen * s)
 {
   XGCValues v={
@@ -90,9 +99,6 @@ static inline void setup_gc(Display * d, struct JBWMScreen * s)
 #endif//JBWM_USE_XFT
   s->gc=DefaultGC(d,s->id);
   XChangeGC(d,s->gc,mask,&v);
-  s->border_gc=XCreateGC(d,s->xlib->root,GCFunction,
-    &(XGCValues){.function=GXxor});
-  XCopyGC(d,s->gc,mask,s->border_gc);
 }
 static inline void setup_event_listeners(Display * d, const Window root)
 {
@@ -113,42 +119,119 @@ static XftDraw * new_xft_draw(Screen * s)
     DefaultVisualOfScreen(s), DefaultColormapOfScreen(s));
 }
 #endif//JBWM_USE_XFT
-// Initialize SCREENS amount of screens.
-void jbwm_init_screens(Display *d, struct JBWMScreen *s,
-  struct JBWMClient ** head_client, struct JBWMClient ** current_client,
-  const short screens)
+/* Read the current desktop of s and set up everything but its clients.
+ * Return the desktop.  */
+static uint8_t init_screen(Display * d, struct JBWMScreen * s,
+  const uint8_t id)
 {
-  if(screens>=0){
-    unsigned long *lprop;
-    uint16_t n;
-    uint8_t vdesk;
-    JBWM_LOG("jbwm_init_screen(d, screens), screens is %d", screens);
-    s->id = screens;
-    s->xlib = ScreenOfDisplay(d, screens);
-    lprop=jbwm_get_property(d,s->xlib->root,
-      jbwm_atoms[JBWM_NET_CURRENT_DESKTOP],&n);
-    if(n){
-      vdesk=lprop[0];
-      XFree(lprop);
-    }else
-      vdesk=0;
+  unsigned long *lprop;
+  uint16_t n;
+  uint8_t vdesk;
+  JBWM_LOG("init_screen(d, s, %d)", id);
+  s->id = id;
+  s->xlib = ScreenOfDisplay(d, id);
+  lprop=jbwm_get_property(d,s->xlib->root,
+    jbwm_atoms[JBWM_NET_CURRENT_DESKTOP],&n);
+  if(n){
+    vdesk=lprop[0];
+    XFree(lprop);
+  }else
+    vdesk=0;
+  jbwm_end_phase(JBWM_PHASE_EWMH);
 #ifdef JBWM_USE_XFT
-    s->xft = new_xft_draw(s->xlib);
+  s->xft = new_xft_draw(s->xlib);
 #else//!JBWM_USE_XFT
-    s->font = jbwm_get_font();
+  s->font = jbwm_get_font();
 #endif//JBWM_USE_XFT
-    s->font_height=jbwm_get_font_height();
-    allocate_colors(s);
-    setup_gc(d, s);
-    { // r scope
-      const Window r = RootWindow(d, screens);
-      setup_event_listeners(d, r);
-      jbwm_grab_root_keys(d, r);
+  s->font_height=jbwm_get_font_height();
+  jbwm_end_phase(JBWM_PHASE_FONT);
+  allocate_colors(s, s - id);
+  setup_gc(d, s);
+  jbwm_end_phase(JBWM_PHASE_COLORS);
+  jbwm_init_monitors(s);
+  setup_event_listeners(d, s->xlib->root);
+  jbwm_grab_root_keys(d, s->xlib->root);
+  jbwm_end_phase(JBWM_PHASE_GRABS);
+  return vdesk;
+}
+/* The windows found on a screen at startup.  Each screen is scanned on a
+ * connection and thread of its own, as the scan is a round trip per
+ * window.  It only reads, so nothing it touches is owned by the
+ * connection.  */
+struct ScreenScan {
+  Display * display;
+  Window * windows;
+  pthread_t thread;
+  uint16_t count;
+  uint8_t id;
+  bool threaded;
+};
+static void * scan(void * arg)
+{
+  struct ScreenScan * s = arg;
+  uint16_t n, i;
+  Window * w = get_windows(s->display, RootWindow(s->display, s->id), &n);
+  s->count = 0;
+  for (i = 0; i < n; ++i)
+    if (check_redirect(s->display, w[i]))
+      w[s->count++] = w[i];
+  s->windows = w;
+  return NULL;
+}
+static void scan_screens(Display * d, struct ScreenScan * s, const uint8_t n)
+{
+  uint8_t i;
+  for (i = 0; i < n; ++i) {
+    s[i].id = i;
+    s[i].display = n > 1 ? XOpenDisplay(DisplayString(d)) : NULL;
+    s[i].threaded = s[i].display
+      && !pthread_create(&s[i].thread, NULL, scan, s + i);
+    if (!s[i].threaded) { // Scan on the main connection instead.
+      if (s[i].display)
+        XCloseDisplay(s[i].display);
+      s[i].display = d;
+      scan(s + i);
+    }
+  }
+  for (i = 0; i < n; ++i)
+    if (s[i].threaded) {
+      pthread_join(s[i].thread, NULL);
+      XCloseDisplay(s[i].display);
     }
-    /* scan all the windows on this screen */
-    setup_clients(d, s, head_client, current_client);
-    jbwm_ewmh_init_screen(d, s);
-    jbwm_init_screens(d, s, head_client, current_client, screens - 1);
-    jbwm_set_vdesk(s, *head_client, vdesk);
+}
+static void setup_clients(struct JBWMScreen * s, struct ScreenScan * scan,
+  struct JBWMClient ** head_client, struct JBWMClient ** current_client)
+{
+  uint16_t n = scan->count;
+  JBWM_LOG("Started with %d clients", n);
+  if (scan->windows) { // Avoid segmentation fault on empty list.
+    while(n--)
+      // Skip the clients restored from a snapshot.
+      if(!jbwm_find_client(*head_client, scan->windows[n]))
+        jbwm_new_client(s, head_client, current_client, scan->windows[n]);
+    XFree(scan->windows);
+  }
+}
+void jbwm_init_screens(Display *d, struct JBWMScreen *s,
+  struct JBWMClient ** head_client, struct JBWMClient ** current_client,
+  const uint8_t n)
+{
+  struct ScreenScan scans[n];
+  uint8_t vdesks[n], i;
+  for (i = 0; i < n; ++i)
+    vdesks[i] = init_screen(d, s + i, i);
+  jbwm_set_screens(s, n);
+  // Redirect every root before scanning, so no new window is missed.
+  XSync(d, false);
+  jbwm_end_phase(JBWM_PHASE_GRABS);
+  scan_screens(d, scans, n);
+  for (i = 0; i < n; ++i) {
+    // Adopt the clients saved by a restart, then any others.
+    jbwm_restore_snapshot(s + i, head_client, current_client);
+    setup_clients(s + i, scans + i, head_client, current_client);
+    jbwm_end_phase(JBWM_PHASE_ADOPTION);
+    jbwm_ewmh_init_screen(d, s + i);
+    jbwm_set_vdesk(s + i, current_client, vdesks[i]);
+    jbwm_end_phase(JBWM_PHASE_EWMH);
   }
 }
@@ -5,9 +5,11 @@
 #ifndef JBWM_JBWM_H
 #define JBWM_JBWM_H
 #include <X11/Xlib.h>
+#include <stdint.h>
 struct JBWMClient;
 struct JBWMScreen;
+// Initialize the n screens of s, and adopt their clients.
 void jbwm_init_screens(Display *d, struct JBWMScreen *s,
   struct JBWMClient ** head_client, struct JBWMClient ** current_client,
-  const short screens);
+  const uint8_t n);
 #endif /* not JBWM_JBWM_H */
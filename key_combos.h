@@ -17,5 +17,5 @@ JBWM_KEY_ALTLOWER, JBWM_KEY_MAX, JBWM_KEY_STICK,\
 JBWM_VWM_KEYS, JBWM_KEY_MOVE, JBWM_KEY_RAISE, JBWM_KEY_SHADE,\
 JBWM_KEY_MAX_H, JBWM_KEY_MAX_V, JBWM_KEY_FS, 0
 #define JBWM_ALT_KEYS_TO_GRAB JBWM_KEY_KILL, JBWM_DIRECTION_KEYS,\
-JBWM_VWM_KEYS, 0
+JBWM_VWM_KEYS, JBWM_KEY_QUIT, 0
 #endif//!JBWM_KEY_COMBOS_H
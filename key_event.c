@@ -3,21 +3,30 @@
 #include "key_event.h"
 /* Local: */
 #include "JBWMClient.h"
+#include "JBWMKeyBinding.h"
 #include "JBWMKeys.h"
 #include "JBWMScreen.h"
 #include "client.h"
+#include "command_line.h"
 #include "config.h"
+#include "crossing.h"
 #include "drag.h"
 #include "exec.h"
+#include "keys.h"
 #include "log.h"
 #include "max.h"
 #include "move_resize.h"
+#include "restart.h"
 #include "select.h"
+#include "size_hints.h"
 #include "snap.h"
 #include "title_bar.h"
+#include "transaction.h"
 #include "vdesk.h"
 #include "wm_state.h"
 /* System: */
+#include <X11/XKBlib.h>
+#include <X11/Xutil.h>
 #include <stdbool.h>
 #include <stdlib.h>
 /* Program: */
@@ -27,7 +36,8 @@ static void point(struct JBWMClient * c,
 {
   Display * d = c->screen->xlib->display;
   XRaiseWindow(d, c->parent);
-  jbwm_warp(d, c->window, x, y);
+  if (jbwm_get_warp())
+    jbwm_warp(d, c->window, x, y);
 }
 __attribute__((nonnull))
 static void commit_key_move(struct JBWMClient * c)
@@ -63,13 +73,90 @@ static int16_t * get_antecedent(struct JBWMClient * c, const
   return ret;
 }
 __attribute__((nonnull))
-static void key_move(struct JBWMClient * c, uint8_t const flags)
+static void key_move(struct JBWMClient * c, uint8_t const flags,
+  int16_t step)
 {
-  int8_t const d = flags & KEY_MOVE_POSITIVE
-  ? JBWM_RESIZE_INCREMENT : - JBWM_RESIZE_INCREMENT;
-  *get_antecedent(c, flags) += d;
+  int16_t * a = get_antecedent(c, flags);
+  const bool resize = a == &c->size.width || a == &c->size.height;
+  if (resize) { // Step by whole increments, such as terminal cells.
+    const uint16_t i = jbwm_get_size_increment(c,
+      flags & KEY_MOVE_HORIZONTAL);
+    step = (step + i - 1) / i * i;
+  }
+  if (!(flags & KEY_MOVE_POSITIVE))
+    step = -step;
+  *a += step;
+  if (resize) {
+    // A merged step must not shrink the window away.
+    if (*a < JBWM_RESIZE_INCREMENT)
+      *a = JBWM_RESIZE_INCREMENT;
+    jbwm_constrain_size(c);
+  }
   commit_key_move(c);
 }
+/* Autorepeat of the move keys.  Steps grow the longer a key is held, and
+ * repeats already queued are merged into one step, so the server is sent
+ * one move per batch of events rather than one per repeat.  */
+enum {
+  KEY_REPEAT_ACCEL_MS = 100, // Add one increment per this much holding.
+  KEY_REPEAT_MAX_FACTOR = 16
+};
+static struct {
+  Time start;
+  unsigned int keycode;
+  bool held;
+} key_repeat;
+static int get_repeat_step(const Time t)
+{
+  const Time factor = 1 + (t - key_repeat.start) / KEY_REPEAT_ACCEL_MS;
+  return JBWM_RESIZE_INCREMENT * (factor < KEY_REPEAT_MAX_FACTOR
+    ? factor : KEY_REPEAT_MAX_FACTOR);
+}
+__attribute__((pure))
+static bool is_same_key(XEvent * e, XKeyEvent * k)
+{
+  return (e->type == KeyPress || e->type == KeyRelease)
+    && e->xkey.keycode == k->keycode && e->xkey.state == k->state;
+}
+/* Return the distance to move for e and the repeats queued right after
+ * it.  Repeats behind any other event stay queued, so a key pressed
+ * while this one is held is handled before them.  */
+__attribute__((nonnull))
+static int16_t get_coalesced_step(XKeyEvent * e, const int16_t limit)
+{
+  Display * d = e->display;
+  XEvent ev;
+  int step;
+  if (!key_repeat.held || key_repeat.keycode != e->keycode) {
+    key_repeat.start = e->time;
+    key_repeat.keycode = e->keycode;
+  }
+  key_repeat.held = true;
+  step = get_repeat_step(e->time);
+  while (XEventsQueued(d, QueuedAlready)) {
+    XPeekEvent(d, &ev);
+    if (!is_same_key(&ev, e))
+      break;
+    XNextEvent(d, &ev);
+    if ((key_repeat.held = ev.type == KeyPress))
+      step += get_repeat_step(ev.xkey.time);
+  }
+  return step < limit ? step : limit;
+}
+// Whether next_client holds the keyboard grab.
+static bool cycle_grabbed;
+void jbwm_handle_key_release(XKeyEvent * e,
+  struct JBWMClient ** current_client)
+{
+  if (e->keycode == key_repeat.keycode)
+    key_repeat.held = false;
+  if (cycle_grabbed && IsModifierKey(XkbKeycodeToKeysym(e->display,
+        e->keycode, 0, 0))) {
+    XUngrabKeyboard(e->display, e->time);
+    cycle_grabbed = false;
+    jbwm_end_focus_cycle(current_client);
+  }
+}
 static uint8_t get_move_flags(const KeySym k, const bool mod)
 {
   uint8_t flags = (mod ? KEY_MOVE_MODIFIER : 0) | KEY_MOVE_POSITIVE;
@@ -85,20 +172,21 @@ static uint8_t get_move_flags(const KeySym k, const bool mod)
   }
   return flags;
 }
-static void handle_key_move(struct JBWMClient * c,
-  const KeySym k, const bool mod)
-{
-  /* These operations invalid when fullscreen. */
-  if (c->opt.fullscreen)
-    return;
-  key_move(c, get_move_flags(k, mod));
-}
+struct JBWMKeyContext {
+  struct JBWMScreen * screen;
+  struct JBWMClient * target, ** head_client, ** current_client;
+  XKeyEvent * event;
+  KeySym key;
+  bool mod;
+};
 static void toggle_maximize(struct JBWMClient * c)
 {
   const struct JBWMClientOptions o = c->opt;
-  /* Honor mwm hints. Do not maximize shaped windows. */
+  /* Honor mwm hints. */
   /* Ignore fullscreen windows. Let the fullscreen code handle them. */
-  if (!o.no_max && !o.fullscreen && !o.shaped) {
+  if (!o.no_max && !o.fullscreen) {
+    // Commit both axes at once.
+    jbwm_begin(c);
     if (o.max_horz && o.max_vert) {
       jbwm_set_not_horz(c);
       jbwm_set_not_vert(c);
@@ -106,150 +194,192 @@ static void toggle_maximize(struct JBWMClient * c)
       jbwm_set_horz(c);
       jbwm_set_vert(c);
     }
+    jbwm_commit(c);
   }
 }
-__attribute__((nonnull))
-static void handle_client_key_event(struct JBWMClient ** head_client,
-  struct JBWMClient ** current_client,
-  const bool mod, const KeySym key)
+static void cond_set_vdesk(struct JBWMKeyContext * k, const uint8_t desktop)
+{
+  if (k->mod && k->target)
+    jbwm_set_client_vdesk(k->target, desktop);
+  else
+    jbwm_set_vdesk(k->screen, k->current_client, desktop);
+}
+/* Actions.  Those bound with client set run only when there is a current
+ * client which is not fullscreen.  */
+static void new_terminal(struct JBWMKeyContext * k __attribute__((unused)))
 {
-  struct JBWMClient * c;
-  JBWM_LOG("handle_client_key_event: %d", (int)key);
-  c=*current_client;
+  jbwm_exec(JBWM_TERM);
+}
+// With the modifier, restart in place instead.
+static void quit(struct JBWMKeyContext * k)
+{
+  if (k->mod)
+    jbwm_restart(k->event->display, *k->head_client, *k->current_client);
+  exit(0);
+}
+// Return true unless the modifiers are known to be released.
+static bool are_modifiers_held(Display * d)
+{
+  XkbStateRec s;
+  return XkbGetState(d, XkbUseCoreKbd, &s) != Success
+    || (s.mods & JBWM_KEYMASK_GRAB);
+}
+/* Cycle through the desktop's clients, most recently focused first.  The
+ * keyboard is grabbed so that releasing the modifiers can be seen, and
+ * only then is the chosen client moved to the front of the list.  */
+static void next_client(struct JBWMKeyContext * k)
+{
+  struct JBWMClient * c = jbwm_cycle_focus(k->screen, k->current_client);
   if (c) {
-    if (c->opt.fullscreen) {
-      /* only allow exiting from fullscreen */
-      if (key == JBWM_KEY_FS)
-        jbwm_set_not_fullscreen(c);
-      return; /* prevent other operations while fullscreen */
-    }
-    switch (key) {
-    case JBWM_KEY_LEFT:
-    case JBWM_KEY_RIGHT:
-    case JBWM_KEY_UP:
-    case JBWM_KEY_DOWN:
-      handle_key_move(c, key, mod);
-      break;
-    case JBWM_KEY_KILL:
-      jbwm_send_wm_delete(c);
-      break;
-    case JBWM_KEY_LOWER:
-    case JBWM_KEY_ALTLOWER:
-      XLowerWindow(c->screen->xlib->display, c->parent);
-      break;
-    case JBWM_KEY_RAISE:
-      XRaiseWindow(c->screen->xlib->display, c->parent);
-      break;
-    case JBWM_KEY_FS:
-      jbwm_set_fullscreen(c);
-      break;
-    case JBWM_KEY_MAX:
-      toggle_maximize(c);
-      break;
-    case JBWM_KEY_MAX_H:
-      (c->opt.max_horz ? jbwm_set_not_horz : jbwm_set_horz)(c);
-      break;
-    case JBWM_KEY_MAX_V:
-      (c->opt.max_vert ? jbwm_set_not_vert : jbwm_set_vert)(c);
-      break;
-    case JBWM_KEY_STICK:
-      jbwm_toggle_sticky(c, current_client);
-      break;
-    case JBWM_KEY_MOVE:
-      jbwm_drag(c, head_client, false);
-      break;
-    case JBWM_KEY_SHADE:
-      jbwm_toggle_shade(c);
-      break;
+    Display * d = k->event->display;
+    point(c, 1, 1);
+    if (!cycle_grabbed) {
+      cycle_grabbed = XGrabKeyboard(d, k->event->root, True,
+        GrabModeAsync, GrabModeAsync, k->event->time) == GrabSuccess;
+      /* A quick tap may release the modifiers before the grab, and that
+       * release went to the client, so end if none is still held.  */
+      if (cycle_grabbed && !are_modifiers_held(d)) {
+        XUngrabKeyboard(d, k->event->time);
+        cycle_grabbed = false;
+      }
+      if (!cycle_grabbed) // cannot see the release, so end now
+        jbwm_end_focus_cycle(k->current_client);
     }
   }
 }
-static void next(struct JBWMClient * c,
-  struct JBWMClient ** current_client, struct JBWMClient ** head_client,
-  uint8_t const v){
-  if(!c->next)
-    c=*(head_client);
-  else
-    c=c->next;
-  if (c!=*current_client) { /* prevent infinite recursion with dessktop */
-    if(c->vdesk != v) {
-      next(c, current_client, head_client, v);
-    } else {
-      point(c, 0, 0);
-      point(c, c->size.width-1, c->size.height-1);
-      jbwm_select_client(c, current_client);
-    }
-  }
+static void goto_desktop(struct JBWMKeyContext * k)
+{
+  /* First desktop 0, per wm-spec */
+  cond_set_vdesk(k, k->key == JBWM_KEY_0 ? 10 : k->key - JBWM_KEY_1);
 }
-static void cond_set_vdesk(struct JBWMClient * c,
-  struct JBWMClient * head_client,
-  struct JBWMScreen * s, const uint8_t desktop, const bool mod)
+static void prev_desktop(struct JBWMKeyContext * k)
 {
-  if (mod && c)
-    jbwm_set_client_vdesk(c, desktop);
-  else
-    jbwm_set_vdesk(s, head_client, desktop);
+  cond_set_vdesk(k, k->screen->vdesk - 1);
+}
+static void next_desktop(struct JBWMKeyContext * k)
+{
+  cond_set_vdesk(k, k->screen->vdesk + 1);
+}
+enum { VDESK_ROW_INCREMENT = 16 };
+static void prev_row(struct JBWMKeyContext * k)
+{
+  cond_set_vdesk(k, k->screen->vdesk - VDESK_ROW_INCREMENT);
+}
+static void next_row(struct JBWMKeyContext * k)
+{
+  cond_set_vdesk(k, k->screen->vdesk + VDESK_ROW_INCREMENT);
+}
+static void move(struct JBWMKeyContext * k)
+{
+  struct JBWMClient * c = *k->current_client;
+  // No step needs to be longer than the screen.
+  key_move(c, get_move_flags(k->key, k->mod), get_coalesced_step(k->event,
+      WidthOfScreen(c->screen->xlib)));
+}
+static void kill_client(struct JBWMKeyContext * k)
+{
+  jbwm_send_wm_delete(*k->current_client);
+}
+static void lower(struct JBWMKeyContext * k)
+{
+  struct JBWMClient * c = *k->current_client;
+  XLowerWindow(c->screen->xlib->display, c->parent);
+}
+static void raise_client(struct JBWMKeyContext * k)
+{
+  struct JBWMClient * c = *k->current_client;
+  XRaiseWindow(c->screen->xlib->display, c->parent);
+}
+// The only action allowed while fullscreen, so it checks for itself.
+static void fullscreen(struct JBWMKeyContext * k)
+{
+  struct JBWMClient * c = *k->current_client;
+  if (c)
+    (c->opt.fullscreen ? jbwm_set_not_fullscreen : jbwm_set_fullscreen)(c);
+}
+static void maximize(struct JBWMKeyContext * k)
+{
+  toggle_maximize(*k->current_client);
+}
+static void maximize_horz(struct JBWMKeyContext * k)
+{
+  struct JBWMClient * c = *k->current_client;
+  (c->opt.max_horz ? jbwm_set_not_horz : jbwm_set_horz)(c);
+}
+static void maximize_vert(struct JBWMKeyContext * k)
+{
+  struct JBWMClient * c = *k->current_client;
+  (c->opt.max_vert ? jbwm_set_not_vert : jbwm_set_vert)(c);
+}
+static void stick(struct JBWMKeyContext * k)
+{
+  jbwm_toggle_sticky(*k->current_client, k->current_client);
+}
+static void drag(struct JBWMKeyContext * k)
+{
+  jbwm_drag(*k->current_client, k->head_client, false);
+}
+static void shade(struct JBWMKeyContext * k)
+{
+  jbwm_toggle_shade(*k->current_client);
+}
+static const struct JBWMKeyBinding bindings[] = {
+  {JBWM_KEY_NEW, new_terminal, false},
+  {JBWM_KEY_QUIT, quit, false},
+  {JBWM_KEY_NEXT, next_client, false},
+  {JBWM_KEY_0, goto_desktop, false},
+  {JBWM_KEY_1, goto_desktop, false},
+  {JBWM_KEY_2, goto_desktop, false},
+  {JBWM_KEY_3, goto_desktop, false},
+  {JBWM_KEY_4, goto_desktop, false},
+  {JBWM_KEY_5, goto_desktop, false},
+  {JBWM_KEY_6, goto_desktop, false},
+  {JBWM_KEY_7, goto_desktop, false},
+  {JBWM_KEY_8, goto_desktop, false},
+  {JBWM_KEY_9, goto_desktop, false},
+  {JBWM_KEY_PREVDESK, prev_desktop, false},
+  {JBWM_KEY_NEXTDESK, next_desktop, false},
+  {JBWM_KEY_VDESK_NEXT_ROW, prev_row, false},
+  {JBWM_KEY_VDESK_PREV_ROW, next_row, false},
+  {JBWM_KEY_LEFT, move, true},
+  {JBWM_KEY_RIGHT, move, true},
+  {JBWM_KEY_UP, move, true},
+  {JBWM_KEY_DOWN, move, true},
+  {JBWM_KEY_KILL, kill_client, true},
+  {JBWM_KEY_LOWER, lower, true},
+  {JBWM_KEY_ALTLOWER, lower, true},
+  {JBWM_KEY_RAISE, raise_client, true},
+  {JBWM_KEY_FS, fullscreen, false},
+  {JBWM_KEY_MAX, maximize, true},
+  {JBWM_KEY_MAX_H, maximize_horz, true},
+  {JBWM_KEY_MAX_V, maximize_vert, true},
+  {JBWM_KEY_STICK, stick, true},
+  {JBWM_KEY_MOVE, drag, true},
+  {JBWM_KEY_SHADE, shade, true},
+};
+const struct JBWMKeyBinding * jbwm_get_keysym_binding(const KeySym key)
+{
+  size_t i;
+  for (i = 0; i < sizeof(bindings) / sizeof(bindings[0]); ++i)
+    if (bindings[i].key == key)
+      return bindings + i;
+  return NULL;
 }
 void jbwm_handle_key_event(struct JBWMScreen * s, struct JBWMClient * target,
   struct JBWMClient ** head_client, struct JBWMClient ** current_client,
   XKeyEvent * e)
 {
-  enum { MOD = 1 << 0, ZERO = 1 << 1, VDESK_ROW_INCREMENT=16};
-  uint8_t flags;
-  const KeySym key = XLookupKeysym(e, 0);
-  flags = e->state & JBWM_KEYMASK_MOD ? MOD : 0;
-  JBWM_LOG("jbwm_handle_key_event mod: %d", flags);
-  switch (key) {
-  case JBWM_KEY_NEW:
-    jbwm_exec(JBWM_TERM);
-    break;
-  case JBWM_KEY_QUIT:
-    exit(0);
-  case JBWM_KEY_NEXT:
-    if(*current_client)
-      next(*current_client, current_client, head_client, s->vdesk);
-    break;
-  case JBWM_KEY_0:
-    flags |= ZERO;
-    /* FALLTHROUGH */
-  case JBWM_KEY_1:
-  case JBWM_KEY_2:
-  case JBWM_KEY_3:
-  case JBWM_KEY_4:
-  case JBWM_KEY_5:
-  case JBWM_KEY_6:
-  case JBWM_KEY_7:
-  case JBWM_KEY_8:
-  case JBWM_KEY_9:
-    /* First desktop 0, per wm-spec */
-    cond_set_vdesk(target, *head_client, s, flags & ZERO
-      ? 10 : key - JBWM_KEY_1, flags & MOD);
-    break;
-  case JBWM_KEY_PREVDESK:
-    cond_set_vdesk(target, *head_client, s, s->vdesk - 1, flags & MOD);
-    break;
-  case JBWM_KEY_NEXTDESK:
-    cond_set_vdesk(target, *head_client, s, s->vdesk + 1, flags & MOD);
-    break;
-  case JBWM_KEY_VDESK_NEXT_ROW:
-    cond_set_vdesk(target, *head_client, s,
-        s->vdesk - VDESK_ROW_INCREMENT, flags & MOD);
-    break;
-  case JBWM_KEY_VDESK_PREV_ROW:
-    cond_set_vdesk(target, *head_client, s,
-      s->vdesk + VDESK_ROW_INCREMENT, flags & MOD);
-    break;
-  default:
-    if (!target)
-      target = *current_client;
-    if (!target)
-      target = *head_client;
-    if (target) {
-      handle_client_key_event(head_client, current_client, flags & MOD, key);
-#ifdef DEBUG
-    } else {
-      JBWM_LOG("target is NULL");
-#endif // DEBUG
-    }
+  const struct JBWMKeyBinding * b = jbwm_get_key_binding(e);
+  JBWM_LOG("jbwm_handle_key_event keycode: %d", (int)e->keycode);
+  if (b) {
+    struct JBWMClient * c = *current_client;
+    if (b->client && (!c || c->opt.fullscreen))
+      return; /* prevent other operations while fullscreen */
+    // Only the action itself may move the focus.
+    jbwm_begin_ignore_enter(e->display);
+    b->action(&(struct JBWMKeyContext){.screen = s, .target = target,
+      .head_client = head_client, .current_client = current_client,
+      .event = e, .key = b->key, .mod = e->state & JBWM_KEYMASK_MOD});
+    jbwm_end_ignore_enter(e->display);
   }
 }
@@ -3,8 +3,16 @@
 #define JBWM_KEY_EVENT_H
 #include <X11/Xlib.h>
 struct JBWMClient;
+struct JBWMKeyBinding;
 struct JBWMScreen;
 void jbwm_handle_key_event(struct JBWMScreen *s, struct JBWMClient * target, 
   struct JBWMClient ** head_client, struct JBWMClient ** current_client,
   XKeyEvent * e);
+/* Note the end of a held key, for autorepeat acceleration, and of the
+ * modifiers held while cycling focus.  */
+void jbwm_handle_key_release(XKeyEvent * e,
+  struct JBWMClient ** current_client) __attribute__((nonnull));
+// Return the binding for key, or NULL, for building the keycode table.
+const struct JBWMKeyBinding * jbwm_get_keysym_binding(const KeySym key)
+__attribute__((const));
 #endif//!JBWM_KEY_EVENT_H
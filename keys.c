@@ -6,28 +6,73 @@
 //
 #include "JBWMKeys.h"
 #include "config.h"
+#include "key_event.h"
 //
+#include <X11/XKBlib.h>
 #include <stdint.h>
+#include <string.h>
 //
-__attribute__((nonnull(1,2)))
-static void grab_r(Display * d, KeySym const * k,
-  Window const r, uint32_t const mask)
+/* Bindings indexed by keycode, then by whether JBWM_KEYMASK_MOD is
+ * held.  Keycodes are per display, so one table serves every screen.  */
+static const struct JBWMKeyBinding * key_table[UINT8_MAX + 1][2];
+// Modifiers which must not stop a binding from matching.
+static unsigned int ignored_mask;
+__attribute__((nonnull))
+static void bind(Display * d, KeySym const * k, const uint8_t mod)
 {
-  if (*k) { // Terminate at KeySym 0
-    XGrabKey(d, XKeysymToKeycode(d, *k), mask, r, True,
-      GrabModeAsync, GrabModeAsync);
-    grab_r(d, k + 1, r, mask);
+  for (; *k; ++k) { // Terminate at KeySym 0
+    const KeyCode kc = XKeysymToKeycode(d, *k);
+    if (kc)
+      key_table[kc][mod] = jbwm_get_keysym_binding(*k);
   }
 }
+// NumLock is not a fixed modifier, so find where it is mapped.
+static unsigned int get_num_lock_mask(Display * d)
+{
+  XModifierKeymap * m = XGetModifierMapping(d);
+  const KeyCode nl = XKeysymToKeycode(d, XK_Num_Lock);
+  unsigned int mask = 0;
+  int i;
+  if (nl)
+    for (i = 0; i < 8 * m->max_keypermod; ++i)
+      if (m->modifiermap[i] == nl)
+        mask |= 1 << (i / m->max_keypermod);
+  XFreeModifiermap(m);
+  return mask;
+}
+void jbwm_update_keys(Display * d)
+{
+  memset(key_table, 0, sizeof(key_table));
+  bind(d, (KeySym[]){JBWM_KEYS_TO_GRAB}, 0);
+  bind(d, (KeySym[]){JBWM_ALT_KEYS_TO_GRAB}, 1);
+  ignored_mask = LockMask | Mod3Mask | get_num_lock_mask(d);
+  /* Have a held key send presses only, without a release before each
+   * repeat, so a hold is seen as one.  Where unsupported, key_event.c
+   * still merges the pairs it finds queued.  */
+  XkbSetDetectableAutoRepeat(d, True, NULL);
+}
 void jbwm_grab_root_keys(Display * d, Window const root)
 {
-  grab_r(d, (KeySym[]){JBWM_KEYS_TO_GRAB}, root, JBWM_KEYMASK_GRAB);
-  grab_r(d, (KeySym[]){JBWM_KEYS_TO_GRAB}, root, JBWM_KEYMASK_GRAB | LockMask);
-  grab_r(d, (KeySym[]){JBWM_KEYS_TO_GRAB}, root, JBWM_KEYMASK_GRAB | Mod3Mask);
-  grab_r(d, (KeySym[]){JBWM_ALT_KEYS_TO_GRAB}, root, JBWM_KEYMASK_GRAB
-    | JBWM_KEYMASK_MOD);
-  grab_r(d, (KeySym[]){JBWM_ALT_KEYS_TO_GRAB}, root, JBWM_KEYMASK_GRAB
-    | JBWM_KEYMASK_MOD | LockMask);
-  grab_r(d, (KeySym[]){JBWM_ALT_KEYS_TO_GRAB}, root, JBWM_KEYMASK_GRAB
-    | JBWM_KEYMASK_MOD | Mod3Mask);
+  unsigned int kc, mod, i;
+  XUngrabKey(d, AnyKey, AnyModifier, root);
+  for (kc = 0; kc <= UINT8_MAX; ++kc)
+    for (mod = 0; mod < 2; ++mod)
+      if (key_table[kc][mod]) {
+        const unsigned int mask = JBWM_KEYMASK_GRAB
+          | (mod ? JBWM_KEYMASK_MOD : 0);
+        // Every combination of the ignored modifiers, including none.
+        for (i = ignored_mask;; i = (i - 1) & ignored_mask) {
+          XGrabKey(d, kc, mask | i, root, True, GrabModeAsync,
+            GrabModeAsync);
+          if (!i)
+            break;
+        }
+      }
+}
+const struct JBWMKeyBinding * jbwm_get_key_binding(XKeyEvent * e)
+{
+  // The whole keyboard may be grabbed, so check for the grab modifiers.
+  return (e->state & JBWM_KEYMASK_GRAB) == JBWM_KEYMASK_GRAB
+    ? key_table[e->keycode & UINT8_MAX]
+    [e->state & JBWM_KEYMASK_MOD ? 1 : 0] : NULL;
 }
@@ -5,6 +5,13 @@
 #ifndef JBWM_KEYS_H
 #define JBWM_KEYS_H
 #include <X11/Xlib.h>
+struct JBWMKeyBinding;
+/* Rebuild the keycode table from the current keyboard mapping.  Call
+ * at startup and on MappingNotify, then grab the keys again.  */
+void jbwm_update_keys(Display * d) __attribute__((nonnull));
 void jbwm_grab_root_keys(Display * d, const Window root)
 __attribute__((nonnull));
+// Return the binding for e, or NULL if the key is not bound.
+const struct JBWMKeyBinding * jbwm_get_key_binding(XKeyEvent * e)
+__attribute__((nonnull, pure));
 #endif//!JBWM_KEYS_H
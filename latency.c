@@ -0,0 +1,294 @@
+// Copyright 2020, Alisa Bedard
+/* Measure how long jbwm takes from input to its effect, as another client
+ * sees it.  Input is injected with XTest, so run this under Xvfb with
+ * jbwm already managing the display, as ./bench does.  Each scenario is
+ * run with each window count given, default 1, 10 and 100, and reported
+ * as a line of JSON:
+ *   cycle    Tab to _NET_ACTIVE_WINDOW changing
+ *   move     l or h to the client's synthetic ConfigureNotify
+ *   drag     Button1 to the drag outline being mapped
+ *   desktop  Right to _NET_CURRENT_DESKTOP changing, through every
+ *            desktop, with the windows spread among them  */
+#include <X11/Xatom.h>
+#include <X11/Xlib.h>
+#include <X11/extensions/XTest.h>
+#include <X11/keysym.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+enum {
+  TIMEOUT_MS = 1000, // a sample taking longer is counted as lost
+  SETTLE_MS = 20, // quiet needed before the next sample
+  DESKTOPS = 256 // Right from the first desktop back to it
+};
+struct Bench {
+  Display * d;
+  Window root, * windows;
+  unsigned int count; // of windows
+  Atom active, desktop, wm_desktop;
+  KeyCode control, alt;
+};
+struct Samples {
+  uint64_t * ns;
+  unsigned int count, lost;
+};
+static uint64_t get_time(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (uint64_t)t.tv_sec * 1000000000 + t.tv_nsec;
+}
+static bool is_property(XEvent * e, const unsigned long atom)
+{
+  return e->type == PropertyNotify && e->xproperty.atom == atom;
+}
+static bool is_configure(XEvent * e, const unsigned long w)
+{
+  return e->type == ConfigureNotify && e->xconfigure.window == w;
+}
+static bool is_reparent(XEvent * e, const unsigned long w)
+{
+  return e->type == ReparentNotify && e->xreparent.window == w;
+}
+// The drag outline is the only override-redirect window jbwm maps then.
+static bool is_outline(XEvent * e, const unsigned long root)
+{
+  return e->type == MapNotify && e->xmap.event == root
+    && e->xmap.override_redirect;
+}
+// Return false if no event matching match arrives in time.
+static bool wait_for(struct Bench * b,
+  bool (*match)(XEvent *, unsigned long), const unsigned long arg)
+{
+  const uint64_t end = get_time() + TIMEOUT_MS * (uint64_t)1000000;
+  for (;;) {
+    uint64_t now;
+    while (XPending(b->d)) {
+      XEvent e;
+      XNextEvent(b->d, &e);
+      if (match(&e, arg))
+        return true;
+    }
+    if ((now = get_time()) >= end)
+      return false;
+    poll(&(struct pollfd){.fd = ConnectionNumber(b->d), .events = POLLIN},
+      1, (end - now) / 1000000 + 1);
+  }
+}
+// Discard events until none has come for SETTLE_MS.
+static void settle(struct Bench * b)
+{
+  XSync(b->d, False);
+  do
+    while (XPending(b->d)) {
+      XEvent e;
+      XNextEvent(b->d, &e);
+    }
+  while (poll(&(struct pollfd){.fd = ConnectionNumber(b->d),
+      .events = POLLIN}, 1, SETTLE_MS) > 0);
+}
+static void hold_modifiers(struct Bench * b, const bool down)
+{
+  XTestFakeKeyEvent(b->d, b->control, down, CurrentTime);
+  XTestFakeKeyEvent(b->d, b->alt, down, CurrentTime);
+}
+static void add(struct Samples * s, const uint64_t begin, const bool found)
+{
+  if (found)
+    s->ns[s->count++] = get_time() - begin;
+  else
+    ++s->lost;
+}
+// Press k with the modifiers jbwm grabs, and time until match.
+static void time_key(struct Bench * b, struct Samples * s, const KeySym k,
+  bool (*match)(XEvent *, unsigned long), const unsigned long arg)
+{
+  const KeyCode kc = XKeysymToKeycode(b->d, k);
+  uint64_t begin;
+  hold_modifiers(b, true);
+  XSync(b->d, False);
+  begin = get_time();
+  XTestFakeKeyEvent(b->d, kc, True, CurrentTime);
+  XFlush(b->d);
+  add(s, begin, wait_for(b, match, arg));
+  XTestFakeKeyEvent(b->d, kc, False, CurrentTime);
+  hold_modifiers(b, false);
+  settle(b);
+}
+static void time_drag(struct Bench * b, struct Samples * s, const Window w)
+{
+  Window child;
+  int x, y;
+  uint64_t begin;
+  XTranslateCoordinates(b->d, w, b->root, 0, 0, &x, &y, &child);
+  XTestFakeMotionEvent(b->d, -1, x + 4, y + 4, CurrentTime);
+  hold_modifiers(b, true);
+  settle(b); // Entering w may change the focus.
+  begin = get_time();
+  XTestFakeButtonEvent(b->d, Button1, True, CurrentTime);
+  XFlush(b->d);
+  add(s, begin, wait_for(b, is_outline, b->root));
+  XTestFakeButtonEvent(b->d, Button1, False, CurrentTime);
+  hold_modifiers(b, false);
+  settle(b);
+}
+// Map count windows, spread among the desktops if spread, and wait.
+static void create_windows(struct Bench * b, const unsigned int count,
+  const bool spread)
+{
+  unsigned int i;
+  b->windows = calloc(count, sizeof(Window));
+  b->count = count;
+  for (i = 0; i < count; ++i) {
+    const unsigned long v = i % DESKTOPS;
+    const Window w = XCreateSimpleWindow(b->d, b->root, 0, 0, 160, 120, 0,
+      0, 0);
+    XSelectInput(b->d, w, StructureNotifyMask);
+    if (spread)
+      XChangeProperty(b->d, w, b->wm_desktop, XA_CARDINAL, 32,
+        PropModeReplace, (unsigned char *)&v, 1);
+    XMapWindow(b->d, w);
+    if (!wait_for(b, is_reparent, w))
+      fprintf(stderr, "Window %u was not managed\n", i);
+    b->windows[i] = w;
+  }
+  settle(b);
+}
+static void destroy_windows(struct Bench * b)
+{
+  while (b->count)
+    XDestroyWindow(b->d, b->windows[--b->count]);
+  free(b->windows);
+  settle(b);
+}
+static Window get_active(struct Bench * b)
+{
+  Atom type;
+  int format;
+  unsigned long n, after;
+  unsigned char * value;
+  Window w = None;
+  if (XGetWindowProperty(b->d, b->root, b->active, 0, 1, False, XA_WINDOW,
+      &type, &format, &n, &after, &value) == Success && value) {
+    if (n)
+      w = *(Window *)value;
+    XFree(value);
+  }
+  return w;
+}
+// Wait for a window manager to announce itself, returning false if none.
+static bool wait_for_wm(struct Bench * b)
+{
+  const Atom check = XInternAtom(b->d, "_NET_SUPPORTING_WM_CHECK", False);
+  unsigned int i;
+  for (i = 0; i < TIMEOUT_MS / SETTLE_MS * 5; ++i) {
+    int n;
+    Atom * a = XListProperties(b->d, b->root, &n);
+    bool found = false;
+    while (n-- > 0)
+      found |= a[n] == check;
+    if (a)
+      XFree(a);
+    if (found)
+      return true;
+    nanosleep(&(struct timespec){.tv_nsec = SETTLE_MS * 1000000}, NULL);
+  }
+  return false;
+}
+static int compare(const void * a, const void * b)
+{
+  const uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+  return x < y ? -1 : x > y;
+}
+static void report(const char * scenario, struct Bench * b,
+  struct Samples * s)
+{
+  const unsigned int n = s->count;
+  if (n) {
+    qsort(s->ns, n, sizeof(*s->ns), compare);
+    printf("{\"scenario\":\"%s\",\"windows\":%u,\"samples\":%u,"
+      "\"lost\":%u,\"p50_us\":%.1f,\"p99_us\":%.1f,\"max_us\":%.1f}\n",
+      scenario, b->count, n, s->lost, s->ns[(n - 1) * 50 / 100] / 1000.0,
+      s->ns[(n - 1) * 99 / 100] / 1000.0, s->ns[n - 1] / 1000.0);
+  } else
+    printf("{\"scenario\":\"%s\",\"windows\":%u,\"samples\":0,"
+      "\"lost\":%u}\n", scenario, b->count, s->lost);
+  fflush(stdout);
+  s->count = s->lost = 0;
+}
+static void run(struct Bench * b, struct Samples * s,
+  const unsigned int windows, const unsigned int samples)
+{
+  unsigned int i;
+  Window w;
+  create_windows(b, windows, false);
+  if (windows > 1) { // There is nothing to cycle to otherwise.
+    for (i = 0; i < samples; ++i)
+      time_key(b, s, XK_Tab, is_property, b->active);
+    report("cycle", b, s);
+  }
+  if ((w = get_active(b))) {
+    for (i = 0; i < samples; ++i)
+      time_key(b, s, i & 1 ? XK_h : XK_l, is_configure, w);
+    report("move", b, s);
+  }
+  for (i = 0; i < samples; ++i)
+    time_drag(b, s, b->windows[windows - 1]);
+  report("drag", b, s);
+  destroy_windows(b);
+  create_windows(b, windows, true);
+  for (i = 0; i < DESKTOPS; ++i)
+    time_key(b, s, XK_Right, is_property, b->desktop);
+  report("desktop", b, s);
+  destroy_windows(b);
+}
+int main(int argc, char ** argv)
+{
+  struct Bench b = {0};
+  struct Samples s = {0};
+  unsigned int samples = 100, i;
+  int opt, n;
+  static const unsigned int default_windows[] = {1, 10, 100};
+  while ((opt = getopt(argc, argv, "n:")) != -1)
+    if (opt != 'n' || (samples = strtoul(optarg, NULL, 10)) < 1) {
+      fprintf(stderr, "%s [-n SAMPLES] [WINDOWS...]\n", argv[0]);
+      return 1;
+    }
+  if (!(b.d = XOpenDisplay(NULL))) {
+    fputs("Cannot open the display\n", stderr);
+    return 1;
+  }
+  if (!XTestQueryExtension(b.d, &n, &n, &n, &n)) {
+    fputs("XTest is not available\n", stderr);
+    return 1;
+  }
+  b.root = DefaultRootWindow(b.d);
+  if (!wait_for_wm(&b)) {
+    fputs("No window manager is running\n", stderr);
+    return 1;
+  }
+  b.active = XInternAtom(b.d, "_NET_ACTIVE_WINDOW", False);
+  b.desktop = XInternAtom(b.d, "_NET_CURRENT_DESKTOP", False);
+  b.wm_desktop = XInternAtom(b.d, "_NET_WM_DESKTOP", False);
+  b.control = XKeysymToKeycode(b.d, XK_Control_L);
+  b.alt = XKeysymToKeycode(b.d, XK_Alt_L);
+  XSelectInput(b.d, b.root, SubstructureNotifyMask | PropertyChangeMask);
+  s.ns = calloc(samples > DESKTOPS ? samples : DESKTOPS, sizeof(*s.ns));
+  if (optind < argc)
+    for (i = optind; i < (unsigned int)argc; ++i) {
+      const unsigned long windows = strtoul(argv[i], NULL, 10);
+      if (windows)
+        run(&b, &s, windows, samples);
+    }
+  else
+    for (i = 0; i < sizeof(default_windows) / sizeof(*default_windows);
+      ++i)
+      run(&b, &s, default_windows[i], samples);
+  free(s.ns);
+  XCloseDisplay(b.d);
+  return 0;
+}
@@ -6,17 +6,40 @@
 #include "JBWMScreen.h"
 #include "atom.h"
 #include "command_line.h"
+#include "control.h"
 #include "display.h"
 #include "events.h"
+#include "exec.h"
+#include "export.h"
 #include "font.h"
 #include "jbwm.h"
+#include "keys.h"
+#include "restart.h"
+#include "startup.h"
+#include "trace.h"
+#include "wake.h"
+#include "worker.h"
 int main(int argc, char **argv)
 {
   Display * d;
   jbwm_parse_command_line(argc, argv);
+  jbwm_set_up_wake();
+  jbwm_set_up_restart(argv);
+  jbwm_set_up_trace();
+  jbwm_set_up_exec();
+  jbwm_begin_startup();
+  jbwm_preload_font();
   d = jbwm_open_display();
+  jbwm_set_up_export(d);
+  jbwm_set_up_control(d);
+  jbwm_set_up_worker(d);
+  jbwm_end_phase(JBWM_PHASE_DISPLAY);
   jbwm_create_atoms(d);
+  jbwm_end_phase(JBWM_PHASE_ATOMS);
   jbwm_open_font(d);
+  jbwm_end_phase(JBWM_PHASE_FONT);
+  jbwm_update_keys(d);
+  jbwm_end_phase(JBWM_PHASE_GRABS);
   {
     struct JBWMClient *current_client, *head_client;
     uint8_t const n = ScreenCount(d);
@@ -26,8 +49,8 @@ int main(int argc, char **argv)
     current_client=NULL; // no clients added yet
     head_client=NULL; // flag as empty list
     jbwm_set_up_error_handler(&head_client, &current_client);
-    jbwm_init_screens(d, s, &head_client, &current_client,
-      n - 1); // -1 for index
+    jbwm_init_screens(d, s, &head_client, &current_client, n);
+    jbwm_report_startup(d);
     jbwm_events_loop(s,&head_client,&current_client); // does not return
   }
 }
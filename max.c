@@ -5,80 +5,84 @@
 #include "font.h"
 #include "atom.h"
 #include "JBWMClient.h"
+#include "monitor.h"
 #include "move_resize.h"
+#include "new.h"
+#include "property.h"
+#include "size_hints.h"
 #include "title_bar.h"
+#include "transaction.h"
+#include <X11/Xatom.h>
 /* In this file, the static companion functions perform the requested option
    directly, while the global functions call the corresponding static
-   function and perform sanity checks and adjustments.  */
+   function and perform sanity checks and adjustments.  Each global
+   function is a transaction, so its state and geometry changes reach the
+   server together, and once when nested in a larger transaction.  */
 static void set_not_horz(struct JBWMClient * c)
 {
-  Display *d;
   c->opt.max_horz = false;
   c->size.x = c->old_size.x;
   c->size.width = c->old_size.width;
-  d=c->screen->xlib->display;
-  jbwm_ewmh_remove_state(d, c->window,
-    jbwm_atoms[JBWM_NET_WM_STATE_MAXIMIZED_HORZ]);
+  jbwm_ewmh_set_state(c, JBWM_NET_WM_STATE_MAXIMIZED_HORZ, false);
 }
 void jbwm_set_not_horz(struct JBWMClient * c)
 {
+  jbwm_begin(c);
   if (c->opt.max_horz)
     set_not_horz(c);
   jbwm_move_resize(c);
+  jbwm_commit(c);
 }
-static void set_horz(struct JBWMClient * c,
-  const uint16_t display_width)
+static void set_horz(struct JBWMClient * c)
 {
+  const union JBWMRectangle * m = jbwm_get_monitor(c->screen, &c->size);
   c->opt.max_horz = true;
   c->old_size.x = c->size.x;
   c->old_size.width = c->size.width;
-  c->size.x = 0;
-  c->size.width = display_width;
+  c->size.x = m->x;
+  c->size.width = m->width;
 }
 void jbwm_set_horz(struct JBWMClient * c)
 {
-  Display *d;
   if (c->opt.max_horz)
     return;
-  d=c->screen->xlib->display;
-  jbwm_ewmh_add_state(d, c->window,
-    jbwm_atoms[JBWM_NET_WM_STATE_MAXIMIZED_HORZ]);
-  set_horz(c, DisplayWidth(d, c->screen->id));
+  jbwm_begin(c);
+  jbwm_ewmh_set_state(c, JBWM_NET_WM_STATE_MAXIMIZED_HORZ, true);
+  set_horz(c);
   c->size.width -= c->opt.border << 1;
   jbwm_move_resize(c);
+  jbwm_commit(c);
 }
 static void set_not_vert(struct JBWMClient * c)
 {
-  Display *d;
   c->opt.max_vert = false;
   c->size.y = c->old_size.y;
   c->size.height = c->old_size.height;
-  d=c->screen->xlib->display;
-  jbwm_ewmh_remove_state(d, c->window,
-    jbwm_atoms[JBWM_NET_WM_STATE_MAXIMIZED_VERT]);
+  jbwm_ewmh_set_state(c, JBWM_NET_WM_STATE_MAXIMIZED_VERT, false);
 }
 void jbwm_set_not_vert(struct JBWMClient * c)
 {
+  jbwm_begin(c);
   if (c->opt.max_vert && !c->opt.shaded)
     set_not_vert(c);
   jbwm_move_resize(c);
+  jbwm_commit(c);
 }
 static void set_vert(struct JBWMClient * c)
 {
-  Display *d;
+  const union JBWMRectangle * m = jbwm_get_monitor(c->screen, &c->size);
   c->opt.max_vert = true;
   c->old_size.y = c->size.y;
   c->old_size.height = c->size.height;
-  c->size.y = 0;
-  d=c->screen->xlib->display;
-  c->size.height = DisplayHeight(d, c->screen->id);
-  jbwm_ewmh_add_state(d, c->window,
-    jbwm_atoms[JBWM_NET_WM_STATE_MAXIMIZED_VERT]);
+  c->size.y = m->y;
+  c->size.height = m->height;
+  jbwm_ewmh_set_state(c, JBWM_NET_WM_STATE_MAXIMIZED_VERT, true);
 }
 void jbwm_set_vert(struct JBWMClient * c)
 {
   if (c->opt.max_vert || c->opt.shaded)
     return;
+  jbwm_begin(c);
   set_vert(c);
   // Offset to hide borders:
   const uint8_t b = c->opt.border;
@@ -89,6 +93,68 @@ void jbwm_set_vert(struct JBWMClient * c)
     c->size.height -= fh + (b << 1);
   }
   jbwm_move_resize(c);
+  jbwm_commit(c);
+}
+/* Fullscreen mode: while a fullscreen client has the focus, the clients
+ * it covers stop reporting property changes and crossings, and catch up
+ * when the mode ends.  */
+static uint8_t fullscreen_screens; // in fullscreen mode
+bool jbwm_get_fullscreen_mode(void)
+{
+  return fullscreen_screens;
+}
+// Whether the frame of c lies within r.
+static bool is_within(struct JBWMClient * c, const union JBWMRectangle * r)
+{
+  const union JBWMRectangle * g = &c->size;
+  const int16_t b = c->opt.border << 1, t = c->opt.no_title_bar
+    || c->opt.fullscreen ? 0 : c->screen->font_height;
+  return g->x >= r->x && g->y - t >= r->y
+    && g->x + g->width + b <= r->x + r->width
+    && g->y + g->height + b <= r->y + r->height;
+}
+static void suspend(struct JBWMClient * c, struct JBWMClient * f)
+{
+  for (; c; c = c->desktop_next)
+    if (c != f && is_within(c, &f->size)) {
+      c->opt.suspended = true;
+      XSelectInput(c->screen->xlib->display, c->window,
+        ColormapChangeMask);
+    }
+}
+static void resume(struct JBWMClient * c)
+{
+  for (; c; c = c->desktop_next)
+    if (c->opt.suspended) {
+      c->opt.suspended = false;
+      // Selected first, so no change falls in between.
+      XSelectInput(c->screen->xlib->display, c->window,
+        JBWM_CLIENT_EVENT_MASK);
+      jbwm_invalidate_size_hints(c);
+      jbwm_read_property(c, XA_WM_NAME);
+      jbwm_read_property(c, jbwm_atoms[JBWM_MOTIF_WM_HINTS]);
+    }
+}
+void jbwm_update_fullscreen_mode(struct JBWMScreen * s)
+{
+  struct JBWMClient * f = s->focus[s->vdesk];
+  size_t v;
+  if (f && !f->opt.fullscreen)
+    f = NULL;
+  if (f == s->fullscreen)
+    return;
+  if (s->fullscreen) {
+    --fullscreen_screens;
+    // Suspended clients may have changed desktops since.
+    for (v = 0; v < sizeof(s->desktops) / sizeof(*s->desktops); ++v)
+      resume(s->desktops[v]);
+    resume(s->sticky);
+  }
+  if ((s->fullscreen = f)) {
+    ++fullscreen_screens;
+    suspend(s->desktops[s->vdesk], f);
+    suspend(s->sticky, f);
+  }
 }
 static void set_not_fullscreen(struct JBWMClient * c)
 {
@@ -96,35 +162,37 @@ static void set_not_fullscreen(struct JBWMClient * c)
   c->size = c->before_fullscreen;
   Display * d = c->screen->xlib->display;
   XSetWindowBorderWidth(d, c->parent, c->opt.border);
-  jbwm_ewmh_remove_state(d, c->window,
-    jbwm_atoms[JBWM_NET_WM_STATE_FULLSCREEN]);
+  jbwm_ewmh_set_state(c, JBWM_NET_WM_STATE_FULLSCREEN, false);
   jbwm_update_title_bar(c);
+  jbwm_update_fullscreen_mode(c->screen);
 }
 void jbwm_set_not_fullscreen(struct JBWMClient * c)
 {
+  jbwm_begin(c);
   if(c->opt.fullscreen)
     set_not_fullscreen(c);
   jbwm_move_resize(c);
+  jbwm_commit(c);
 }
 static void set_fullscreen(struct JBWMClient * c)
 {
   Display *d;
-  const uint8_t id = c->screen->id;
   c->opt.fullscreen = true;
   c->before_fullscreen = c->size;
-  c->size.x = c->size.y = 0;
+  // Fill the monitor the window is mostly on.
+  c->size = *jbwm_get_monitor(c->screen, &c->size);
   d = c->screen->xlib->display;
-  c->size.width = DisplayWidth(d, id);
-  c->size.height = DisplayHeight(d, id);
   XSetWindowBorderWidth(d, c->parent, 0);
-  jbwm_ewmh_add_state(d, c->window,
-    jbwm_atoms[JBWM_NET_WM_STATE_FULLSCREEN]);
+  jbwm_ewmh_set_state(c, JBWM_NET_WM_STATE_FULLSCREEN, true);
   jbwm_update_title_bar(c);
+  jbwm_update_fullscreen_mode(c->screen);
 }
 void jbwm_set_fullscreen(struct JBWMClient * c)
 {
   if (c->opt.fullscreen || c->opt.shaded || c->opt.no_max)
     return;
+  jbwm_begin(c);
   set_fullscreen(c);
   jbwm_move_resize(c);
+  jbwm_commit(c);
 }
@@ -2,7 +2,9 @@
 #ifndef JBWM_MAX_H
 #define JBWM_MAX_H
 #include <X11/Xlib.h>
+#include <stdbool.h>
 struct JBWMClient;
+struct JBWMScreen;
 void jbwm_set_horz(struct JBWMClient * c)
 __attribute__((nonnull));
 void jbwm_set_not_horz(struct JBWMClient * c)
@@ -15,4 +17,10 @@ void jbwm_set_fullscreen(struct JBWMClient * c)
 __attribute__((nonnull));
 void jbwm_set_not_fullscreen(struct JBWMClient * c)
 __attribute__((nonnull));
+/* Enter fullscreen mode on s while the client last focused on the desktop
+ * shown is fullscreen, and leave it otherwise.  */
+void jbwm_update_fullscreen_mode(struct JBWMScreen * s)
+__attribute__((nonnull));
+// Whether any screen is in fullscreen mode.
+bool jbwm_get_fullscreen_mode(void) __attribute__((pure));
 #endif//!JBWM_MAX_H
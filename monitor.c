@@ -0,0 +1,91 @@
+// Copyright 2020, Alisa Bedard
+#include "monitor.h"
+#include "JBWMScreen.h"
+#include "log.h"
+#include "screen.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#ifdef JBWM_USE_XRANDR
+#include <X11/extensions/Xrandr.h>
+#endif//JBWM_USE_XRANDR
+static void set_whole_screen(struct JBWMScreen * s)
+{
+  s->monitors = malloc(sizeof(union JBWMRectangle));
+  s->monitors[0] = (union JBWMRectangle){.width = s->xlib->width,
+    .height = s->xlib->height};
+  s->monitor_count = 1;
+}
+#ifdef JBWM_USE_XRANDR
+// Return true if RandR reported any monitors.
+static bool load_monitors(struct JBWMScreen * s)
+{
+  int n, i;
+  XRRMonitorInfo * m = XRRGetMonitors(s->xlib->display, s->xlib->root,
+    True, &n);
+  if (!m)
+    return false;
+  if (n > UINT8_MAX)
+    n = UINT8_MAX;
+  if (n > 0) {
+    s->monitors = malloc(n * sizeof(union JBWMRectangle));
+    for (i = 0; i < n; ++i)
+      s->monitors[i] = (union JBWMRectangle){.x = m[i].x, .y = m[i].y,
+        .width = m[i].width, .height = m[i].height};
+    s->monitor_count = n;
+  }
+  XRRFreeMonitors(m);
+  return n > 0;
+}
+#endif//JBWM_USE_XRANDR
+static void update_monitors(struct JBWMScreen * s)
+{
+  free(s->monitors);
+#ifdef JBWM_USE_XRANDR
+  if (load_monitors(s))
+    return;
+#endif//JBWM_USE_XRANDR
+  set_whole_screen(s);
+}
+void jbwm_init_monitors(struct JBWMScreen * s)
+{
+#ifdef JBWM_USE_XRANDR
+  if (jbwm_get_monitor_event(s->xlib->display) >= 0)
+    XRRSelectInput(s->xlib->display, s->xlib->root,
+      RRScreenChangeNotifyMask);
+#endif//JBWM_USE_XRANDR
+  update_monitors(s);
+}
+const union JBWMRectangle * jbwm_get_monitor(struct JBWMScreen * s,
+  const union JBWMRectangle * g)
+{
+  const int x = g->x + (g->width >> 1), y = g->y + (g->height >> 1);
+  uint8_t i;
+  for (i = 0; i < s->monitor_count; ++i) {
+    const union JBWMRectangle * m = s->monitors + i;
+    if (x >= m->x && x < m->x + m->width && y >= m->y
+      && y < m->y + m->height)
+      return m;
+  }
+  return s->monitors;
+}
+#ifdef JBWM_USE_XRANDR
+int jbwm_get_monitor_event(Display * d)
+{
+  static int event = -1;
+  static bool queried;
+  if (!queried) {
+    int e, error;
+    if (XRRQueryExtension(d, &e, &error))
+      event = e + RRScreenChangeNotify;
+    queried = true;
+  }
+  return event;
+}
+void jbwm_handle_monitor_event(XEvent * ev)
+{
+  JBWM_LOG("jbwm_handle_monitor_event");
+  // Also updates the screen size Xlib keeps.
+  XRRUpdateConfiguration(ev);
+  update_monitors(jbwm_get_screen(ev->xany.window));
+}
+#endif//JBWM_USE_XRANDR
@@ -0,0 +1,23 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_MONITOR_H
+#define JBWM_MONITOR_H
+#include <X11/Xlib.h>
+union JBWMRectangle;
+struct JBWMScreen;
+/* Load the monitors of s.  Without RandR, or if it reports none, the
+ * whole screen is one monitor.  */
+void jbwm_init_monitors(struct JBWMScreen * s) __attribute__((nonnull));
+/* Return the monitor of s under the centre of g, or the first monitor.
+ * This only reads the table, so it is fit for the hot path.  */
+const union JBWMRectangle * jbwm_get_monitor(struct JBWMScreen * s,
+  const union JBWMRectangle * g) __attribute__((nonnull, pure));
+#ifdef JBWM_USE_XRANDR
+// Return the RRScreenChangeNotify event type, or -1 without RandR.
+int jbwm_get_monitor_event(Display * d) __attribute__((nonnull));
+// Reload the monitors of the screen which changed.
+void jbwm_handle_monitor_event(XEvent * ev) __attribute__((nonnull));
+#else//!JBWM_USE_XRANDR
+#define jbwm_get_monitor_event(d) -1
+#define jbwm_handle_monitor_event(ev) (void)(ev)
+#endif//JBWM_USE_XRANDR
+#endif//!JBWM_MONITOR_H
@@ -6,7 +6,6 @@
 #include "JBWMClient.h"
 #include "font.h"
 #include "log.h"
-#include "mwm.h"
 #include "shape.h"
 #include "title_bar.h"
 static void jbwm_configure_client(struct JBWMClient * c)
@@ -21,27 +20,44 @@ static void jbwm_configure_client(struct JBWMClient * c)
     .window = w, .above = c->parent, .override_redirect = true,
     .border_width = c->opt.border});
 }
-static void do_move(Display * d, const Window parent,
-  const Window window, union JBWMRectangle * sz,
-  const uint8_t offset)
+void jbwm_invalidate_geometry(struct JBWMClient * c)
 {
-  XMoveResizeWindow(d, parent, sz->x, sz->y - offset,
-    sz->width, sz->height + offset);
-  XMoveResizeWindow(d, window, 0, offset,
-    sz->width, sz->height);
+  c->committed.width = 0;
 }
+/* Only send the requests the change requires.  A pure move is a single
+ * XMoveWindow on the frame, the client is only touched when its size or
+ * offset within the frame changes, and a no-op sends nothing.  */
 void jbwm_move_resize(struct JBWMClient * c)
 {
+  if (c->transaction.depth) {
+    c->transaction.geometry = true; // sent by jbwm_commit
+    return;
+  }
   struct JBWMClientOptions * o = &c->opt;
   const uint8_t offset = o->no_title_bar || o->fullscreen
   ? 0 : c->screen->font_height;
-  if(offset) { // Leave braces in case title bar support was disabled.
-    jbwm_handle_mwm_hints(c);
-    jbwm_update_title_bar(c);
-  } // Skip shaped and fullscreen clients.
-  union JBWMRectangle * s = &c->size;
-  do_move(c->screen->xlib->display, c->parent, c->window, s, offset);
-  jbwm_set_shape(c);
+  union JBWMRectangle * s = &c->size, * p = &c->committed;
+  const bool moved = s->x != p->x || s->y != p->y;
+  const bool resized = s->width != p->width || s->height != p->height;
+  const bool reoffset = offset != c->committed_offset;
+  Display * d = c->screen->xlib->display;
+  if (!(moved || resized || reoffset))
+    return;
+  if (resized || reoffset) {
+    XMoveResizeWindow(d, c->parent, s->x, s->y - offset,
+      s->width, s->height + offset);
+    if (resized)
+      XMoveResizeWindow(d, c->window, 0, offset, s->width, s->height);
+    else
+      XMoveWindow(d, c->window, 0, offset);
+    // The title bar only depends upon the width.
+    if (offset && (reoffset || s->width != p->width))
+      jbwm_update_title_bar(c);
+    if (resized)
+      jbwm_set_shape(c);
+  } else
+    XMoveWindow(d, c->parent, s->x, s->y - offset);
+  *p = *s;
+  c->committed_offset = offset;
   jbwm_configure_client(c);
 }
-
@@ -5,5 +5,8 @@
 #ifndef JBWM_MOVE_RESIZE_H
 #define JBWM_MOVE_RESIZE_H
 struct JBWMClient;
+// Commit c->size to the server, sending only what changed.
 void jbwm_move_resize(struct JBWMClient * c);
+// Force the next jbwm_move_resize to resend all of c's geometry.
+void jbwm_invalidate_geometry(struct JBWMClient * c);
 #endif//!JBWM_MOVE_RESIZE_H
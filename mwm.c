@@ -38,10 +38,11 @@ static void do_decorations(struct JBWMClientOptions * o,
 }
 void jbwm_handle_mwm_hints(struct JBWMClient * c)
 {
-  Display * d = c->screen->xlib->display;
-  const Atom mwm_hints = jbwm_atoms[JBWM_MOTIF_WM_HINTS];
-  struct JBWMMwm * m = jbwm_get_property(d, c->window,
-    mwm_hints, &(uint16_t){0});
+  jbwm_apply_mwm_hints(c, jbwm_get_property(c->screen->xlib->display,
+    c->window, jbwm_atoms[JBWM_MOTIF_WM_HINTS], &(uint16_t){0}));
+}
+void jbwm_apply_mwm_hints(struct JBWMClient * c, struct JBWMMwm * m)
+{
   if (m) { // property successfully retrieved
     struct JBWMClientOptions * o = &c->opt;
     if (!((c->opt.tearoff = m->flags
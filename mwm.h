@@ -5,5 +5,8 @@
 #ifndef JBWM_MWM_H
 #define JBWM_MWM_H
 struct JBWMClient;
+struct JBWMMwm;
 void jbwm_handle_mwm_hints(struct JBWMClient * c);
+// Apply hints m, as read from _MOTIF_WM_HINTS, and XFree them.
+void jbwm_apply_mwm_hints(struct JBWMClient * c, struct JBWMMwm * m);
 #endif//!JBWM_MWM_H
@@ -5,16 +5,20 @@
 #include "new.h"
 #include "client.h"
 #include "config.h" // for JBWM_MAX_DESKTOPS
+#include "crossing.h"
 #include "ewmh.h"
 #include "geometry.h"
 #include "atom.h"
 #include "JBWMClient.h"
 //#include "keys.h"
 #include "log.h" // for JBWM_LOG
+#include "move_resize.h"
 #include "mwm.h" // for jbwm_handle_mwm_hints
+#include "place.h"
 #include "select.h"
 #include "shape.h" // for jbwm_new_shaped_client
 #include "snap.h"
+#include "title_bar.h"
 #include <stdlib.h>
 #include "util.h"
 #include "vdesk.h"
@@ -86,29 +90,56 @@ static void do_grabs(Display * d, const Window w)
 {
   // jbwm_ewmh_set_allowed_actions must come before jbwm_grab_buttons.
   jbwm_ewmh_set_allowed_actions(d, w);
-  XSelectInput(d, w, EnterWindowMask | PropertyChangeMask
-    | ColormapChangeMask);
+  XSelectInput(d, w, JBWM_CLIENT_EVENT_MASK);
   // keys to grab:
   jbwm_grab_button(d, w, JBWM_KEYMASK_GRAB);//jbwm_get_grab_mask());
 }
+void jbwm_new_client_from_snapshot(struct JBWMClient * c,
+  struct JBWMClient ** head_client)
+{
+  Display * d = c->screen->xlib->display;
+  c->next = *head_client;
+  *head_client = c;
+  do_grabs(d, c->window);
+  jbwm_fetch_title(c);
+  jbwm_track_shape(c);
+  reparent_window(d, c->parent = get_parent(c), c->window);
+  jbwm_set_frame_extents(c);
+  jbwm_link_client(c);
+  // Geometry, shape and title bar follow from the saved state.
+  jbwm_move_resize(c);
+  if (c->opt.sticky || c->screen->vdesk == c->vdesk)
+    jbwm_restore_client(c);
+  else
+    jbwm_hide_client(c);
+}
 void jbwm_new_client(struct JBWMScreen * s,
   struct JBWMClient ** head_client,
   struct JBWMClient ** current_client,
   Window const w)
 {
   struct JBWMClient * c = get_JBWMClient(w, s);
+  Display * d = s->xlib->display;
   JBWM_LOG("jbwm_new_client(..., w: %d)", (int)w);
+  // The new client is selected here, not by the pointer it appears under.
+  jbwm_begin_ignore_enter(d);
   /* Prepend client.  */
   c->next=*head_client;
   *head_client=c;
-  do_grabs(s->xlib->display, w);
-  jbwm_set_client_geometry(c);
+  do_grabs(d, w);
+  const bool positioned = jbwm_set_client_geometry(c);
+  jbwm_fetch_title(c);
   jbwm_handle_mwm_hints(c);
   reparent(c);
   c->vdesk = get_vdesk(c);
+  // Placed among the clients of its desktop, before joining them.
+  if (!positioned)
+    jbwm_place_client(c);
+  jbwm_link_client(c);
   jbwm_snap_client(c, head_client);
   jbwm_restore_client(c);
   jbwm_select_client(c, current_client);
   if(c->screen->vdesk!=c->vdesk)
     jbwm_hide_client(c);
+  jbwm_end_ignore_enter(d);
 }
@@ -7,6 +7,13 @@
 #include <X11/Xlib.h>
 struct JBWMClient;
 struct JBWMScreen;
+// Events selected on client windows.
+enum { JBWM_CLIENT_EVENT_MASK = EnterWindowMask | PropertyChangeMask
+  | ColormapChangeMask };
 void jbwm_new_client(struct JBWMScreen * s, struct JBWMClient **head_client,
   struct JBWMClient ** current_client, Window const w);
+/* Manage c, whose window, geometry, options and desktop were restored
+ * from a snapshot, without querying the server.  */
+void jbwm_new_client_from_snapshot(struct JBWMClient * c,
+  struct JBWMClient ** head_client);
 #endif//!JBWM_NEW_H
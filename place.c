@@ -0,0 +1,173 @@
+// Copyright 2020, Alisa Bedard
+#include "place.h"
+#include "JBWMClient.h"
+#include "JBWMScreen.h"
+#include "command_line.h"
+#include "macros.h"
+#include "monitor.h"
+#include <stdlib.h>
+/* A change in the slope of the overlap, as a function of y, where frame
+ * begins or stops entering or leaving the window being placed.  Its size
+ * is sign times the frame's overlap in x, so it depends on the x tried,
+ * but its y does not.  */
+struct Slope {
+  int32_t y;
+  uint16_t frame;
+  int8_t sign;
+};
+// Return c's frame, its border and title bar included.
+static union JBWMRectangle get_frame(struct JBWMClient * c)
+{
+  const int16_t b = c->opt.border << 1,
+        t = c->opt.no_title_bar ? 0 : c->screen->font_height;
+  return (union JBWMRectangle){.x = c->size.x, .y = c->size.y - t,
+    .width = c->size.width + b, .height = c->size.height + t + b};
+}
+static int compare_slopes(const void * a, const void * b)
+{
+  const int32_t x = ((const struct Slope *)a)->y,
+        y = ((const struct Slope *)b)->y;
+  return (x > y) - (x < y);
+}
+static int compare_ints(const void * a, const void * b)
+{
+  const int32_t x = *(const int32_t *)a, y = *(const int32_t *)b;
+  return (x > y) - (x < y);
+}
+/* Return the least overlap with a window whose overlap in x with each
+ * frame is o, for y from y0 to y1, and set best_y to where it is.  The
+ * overlap is piecewise linear in y, so sweep its m breakpoints e, sorted
+ * by y, accumulating the slope, rather than testing every y.  */
+static int64_t sweep(const struct Slope * e, const uint16_t m,
+  const int32_t * o, const int32_t y0, const int32_t y1, int32_t * best_y)
+{
+  int64_t best = INT64_MAX, f = 0, slope = 0;
+  int32_t prev;
+  uint16_t i;
+  // Nothing overlaps before the first breakpoint.
+  for (prev = e[i = 0].y; i < m;) {
+    const int32_t y = e[i].y;
+    f += slope * (y - prev);
+    prev = y;
+    for (; i < m && e[i].y == y; ++i)
+      slope += e[i].sign * (int64_t)o[e[i].frame];
+    if (y >= y0 && y <= y1 && f < best) {
+      best = f;
+      *best_y = y;
+    }
+  }
+  return best;
+}
+/* The least overlap is where an edge of the window meets an edge of a
+ * frame or of the monitor, so only those x need sweeping.  The
+ * breakpoints in y are sorted once for all of them.  */
+static void place_smart(union JBWMRectangle * g,
+  const union JBWMRectangle * m, const union JBWMRectangle * r,
+  const uint16_t n)
+{
+  const int32_t x0 = m->x, x1 = JB_MAX(x0, m->x + m->width - g->width),
+        y0 = m->y, y1 = JB_MAX(y0, m->y + m->height - g->height);
+  const int32_t h = g->height;
+  int32_t * xs = malloc((4 * n + 2) * sizeof(int32_t));
+  int32_t * o = malloc((n + 1) * sizeof(int32_t));
+  struct Slope * e = malloc((4 * n + 2) * sizeof(struct Slope));
+  int64_t best = INT64_MAX;
+  uint16_t i, k = 0, l = 0;
+  if (xs && o && e) {
+    xs[k++] = x0;
+    xs[k++] = x1;
+    for (i = 0; i < n; ++i) {
+      const int32_t c[] = {r[i].x - g->width, r[i].x,
+        r[i].x + r[i].width - g->width, r[i].x + r[i].width};
+      uint8_t j;
+      for (j = 0; j < 4; ++j)
+        if (c[j] >= x0 && c[j] <= x1)
+          xs[k++] = c[j];
+      e[l++] = (struct Slope){r[i].y - h, i, 1};
+      e[l++] = (struct Slope){r[i].y, i, -1};
+      e[l++] = (struct Slope){r[i].y + r[i].height - h, i, -1};
+      e[l++] = (struct Slope){r[i].y + r[i].height, i, 1};
+    }
+    // Frame n never overlaps, so the ends of the range are evaluated too.
+    o[n] = 0;
+    e[l++] = (struct Slope){y0, n, 0};
+    e[l++] = (struct Slope){y1, n, 0};
+    qsort(xs, k, sizeof(*xs), compare_ints);
+    qsort(e, l, sizeof(*e), compare_slopes);
+    for (i = 0; i < k && best; ++i) {
+      int32_t y = y0;
+      int64_t f;
+      uint16_t j;
+      if (i && xs[i] == xs[i - 1])
+        continue;
+      for (j = 0; j < n; ++j)
+        o[j] = JB_MAX(0, JB_MIN(xs[i] + g->width, r[j].x + r[j].width)
+          - JB_MAX(xs[i], r[j].x));
+      f = sweep(e, l, o, y0, y1, &y);
+      if (f < best) {
+        best = f;
+        g->x = xs[i];
+        g->y = y;
+      }
+    }
+  }
+  free(xs);
+  free(o);
+  free(e);
+}
+// Step down and right from the monitor's corner, one step per frame.
+static void place_cascade(union JBWMRectangle * g,
+  const union JBWMRectangle * m, const uint16_t n, const int16_t step)
+{
+  const int32_t room = JB_MIN(m->width - g->width,
+    m->height - g->height) / step + 1;
+  const int32_t offset = room > 0 ? n % room * step : 0;
+  g->x = m->x + offset;
+  g->y = m->y + offset;
+}
+static void place_center(union JBWMRectangle * g,
+  const union JBWMRectangle * m)
+{
+  g->x = m->x + ((m->width - g->width) >> 1);
+  g->y = m->y + ((m->height - g->height) >> 1);
+}
+// Store the frames on c's desktop in r, if not NULL, and return the count.
+static uint16_t get_frames(struct JBWMClient * c, union JBWMRectangle * r)
+{
+  struct JBWMScreen * s = c->screen;
+  struct JBWMClient * i, * const lists[] = {s->desktops[c->vdesk],
+    s->sticky};
+  uint16_t n = 0;
+  uint8_t l;
+  for (l = 0; l < 2; ++l)
+    for (i = lists[l]; i; i = i->desktop_next, ++n)
+      if (r)
+        r[n] = get_frame(i);
+  return n;
+}
+void jbwm_place_client(struct JBWMClient * c)
+{
+  union JBWMRectangle g = get_frame(c);
+  const union JBWMRectangle * m = jbwm_get_monitor(c->screen, &c->size);
+  const uint16_t n = get_frames(c, NULL);
+  switch (jbwm_get_placement()) {
+  case JBWM_PLACE_SMART: {
+    union JBWMRectangle * r = malloc((n + 1) * sizeof(*r));
+    if (r) {
+      get_frames(c, r);
+      place_smart(&g, m, r, n);
+      free(r);
+    }
+    break;
+  }
+  case JBWM_PLACE_CASCADE:
+    place_cascade(&g, m, n, c->screen->font_height + (c->opt.border << 1));
+    break;
+  case JBWM_PLACE_CENTER:
+    place_center(&g, m);
+    break;
+  }
+  // Back from the frame to the client.
+  c->size.x = g.x;
+  c->size.y = g.y + (c->opt.no_title_bar ? 0 : c->screen->font_height);
+}
@@ -0,0 +1,9 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_PLACE_H
+#define JBWM_PLACE_H
+struct JBWMClient;
+/* Position c, which has not positioned itself, on its monitor by the
+ * placement policy.  c must not be linked yet, its desktop must be set,
+ * and only its position changes.  */
+void jbwm_place_client(struct JBWMClient * c) __attribute__((nonnull));
+#endif//!JBWM_PLACE_H
@@ -0,0 +1,35 @@
+// Copyright 2020, Alisa Bedard
+#include "property.h"
+#include <X11/Xatom.h>
+#include <stdint.h>
+#include "JBWMClient.h"
+#include "ewmh.h"
+#include "move_resize.h"
+#include "mwm.h"
+#include "title_bar.h"
+#include "util.h"
+#include "worker.h"
+void jbwm_read_property(struct JBWMClient * c, const Atom atom)
+{
+  if (!jbwm_post_property(c->window, atom))
+    jbwm_apply_property(c, atom, jbwm_get_property(c->screen->xlib->display,
+        c->window, atom, &(uint16_t){0}));
+}
+void jbwm_apply_property(struct JBWMClient * c, const Atom atom,
+  void * value)
+{
+  if (!c) {
+    if (value)
+      XFree(value);
+  } else if (atom == XA_WM_NAME) {
+    jbwm_set_title(c, value);
+    jbwm_update_title_bar(c);
+  } else {
+    /* Decorations are no longer re-read on every move, so pick up
+     * changes here.  */
+    jbwm_apply_mwm_hints(c, value);
+    jbwm_set_frame_extents(c);
+    jbwm_update_title_bar(c);
+    jbwm_move_resize(c);
+  }
+}
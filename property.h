@@ -0,0 +1,14 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_PROPERTY_H
+#define JBWM_PROPERTY_H
+#include <X11/Xlib.h>
+struct JBWMClient;
+/* Read WM_NAME or _MOTIF_WM_HINTS of c again.  The worker reads it if it
+ * is free, and the result is applied when it returns.  */
+void jbwm_read_property(struct JBWMClient * c, const Atom atom)
+__attribute__((nonnull));
+/* Apply value, as read from property atom of c, and XFree it.  c is NULL
+ * if it has gone since the property was asked for.  */
+void jbwm_apply_property(struct JBWMClient * c, const Atom atom,
+  void * value);
+#endif//!JBWM_PROPERTY_H
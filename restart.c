@@ -0,0 +1,199 @@
+// Copyright 2020, Alisa Bedard
+#include "restart.h"
+#include "JBWMClient.h"
+#include "JBWMScreen.h"
+#include "client.h"
+#include "log.h"
+#include "new.h"
+#include "select.h"
+#include "util.h"
+#include "wake.h"
+#include <X11/Xatom.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+/* A snapshot is a CARDINAL array: a header, then one record per client in
+ * stacking order, bottom first.  Bump the version whenever the record or
+ * struct JBWMClientOptions changes, so an older snapshot is ignored.  */
+enum {
+  SNAPSHOT_VERSION = 2,
+  SNAPSHOT_HEADER = 3 // version, record length, focused window
+};
+enum SnapshotField {
+  SNAP_WINDOW,
+  SNAP_SIZE,
+  SNAP_OLD_SIZE = SNAP_SIZE + 4,
+  SNAP_BEFORE_FULLSCREEN = SNAP_OLD_SIZE + 4,
+  SNAP_SHAPE = SNAP_BEFORE_FULLSCREEN + 4,
+  SNAP_OPTIONS = SNAP_SHAPE + 4,
+  SNAP_VDESK,
+  SNAP_CMAP,
+  SNAP_FIELDS
+};
+static char ** saved_argv;
+static volatile sig_atomic_t requested;
+static void handle_hangup(int sig __attribute__((unused)))
+{
+  requested = 1;
+  jbwm_wake();
+}
+void jbwm_set_up_restart(char ** argv)
+{
+  struct sigaction a;
+  saved_argv = argv;
+  memset(&a, 0, sizeof(a));
+  // The wake pipe ends the wait for events.
+  a.sa_handler = handle_hangup;
+  a.sa_flags = SA_RESTART;
+  sigaction(SIGHUP, &a, NULL);
+}
+bool jbwm_get_restart_requested(void)
+{
+  return requested;
+}
+static Atom get_atom(Display * d)
+{
+  static Atom a;
+  if (!a)
+    a = XInternAtom(d, "_JBWM_SNAPSHOT", false);
+  return a;
+}
+static void put_rectangle(long * r, const union JBWMRectangle * g)
+{
+  uint8_t i;
+  for (i = 0; i < 4; ++i)
+    r[i] = g->array[i];
+}
+static void get_rectangle(union JBWMRectangle * g, const long * r)
+{
+  uint8_t i;
+  for (i = 0; i < 4; ++i)
+    g->array[i] = r[i];
+}
+static void pack(long * r, struct JBWMClient * c)
+{
+  struct JBWMClientOptions o = c->opt;
+  r[SNAP_WINDOW] = c->window;
+  put_rectangle(r + SNAP_SIZE, &c->size);
+  put_rectangle(r + SNAP_OLD_SIZE, &c->old_size);
+  put_rectangle(r + SNAP_BEFORE_FULLSCREEN, &c->before_fullscreen);
+  put_rectangle(r + SNAP_SHAPE, &c->shape);
+  // The new process selects the full event mask again.
+  o.suspended = false;
+  r[SNAP_OPTIONS] = 0;
+  memcpy(r + SNAP_OPTIONS, &o, sizeof(o));
+  r[SNAP_VDESK] = c->vdesk;
+  r[SNAP_CMAP] = c->cmap;
+}
+static struct JBWMClient * unpack(struct JBWMScreen * s, const long * r)
+{
+  struct JBWMClient * c = calloc(1, sizeof(struct JBWMClient));
+  c->screen = s;
+  c->window = r[SNAP_WINDOW];
+  get_rectangle(&c->size, r + SNAP_SIZE);
+  get_rectangle(&c->old_size, r + SNAP_OLD_SIZE);
+  get_rectangle(&c->before_fullscreen, r + SNAP_BEFORE_FULLSCREEN);
+  get_rectangle(&c->shape, r + SNAP_SHAPE);
+  memcpy(&c->opt, r + SNAP_OPTIONS, sizeof(c->opt));
+  c->vdesk = r[SNAP_VDESK];
+  c->cmap = r[SNAP_CMAP];
+  return c;
+}
+// Find the client framed by w, which is not necessarily a client.
+static struct JBWMClient * get_framed(struct JBWMClient * c, const Window w)
+{
+  c = jbwm_find_client(c, w);
+  return c && c->parent == w ? c : NULL;
+}
+static void save_screen(Display * d, const int screen,
+  struct JBWMClient * head_client, struct JBWMClient * current_client)
+{
+  Window * w, root, parent;
+  unsigned int n, i;
+  long * p, * r;
+  root = RootWindow(d, screen);
+  // The frames are listed bottom first, which gives the stacking order.
+  if (!XQueryTree(d, root, &root, &parent, &w, &n))
+    return;
+  p = malloc((SNAPSHOT_HEADER + (size_t)n * SNAP_FIELDS) * sizeof(long));
+  p[0] = SNAPSHOT_VERSION;
+  p[1] = SNAP_FIELDS;
+  p[2] = current_client ? current_client->window : None;
+  r = p + SNAPSHOT_HEADER;
+  for (i = 0; i < n; ++i) {
+    struct JBWMClient * c = get_framed(head_client, w[i]);
+    if (c && c->screen->id == screen) {
+      pack(r, c);
+      r += SNAP_FIELDS;
+    }
+  }
+  XChangeProperty(d, root, get_atom(d), XA_CARDINAL, 32, PropModeReplace,
+    (unsigned char *)p, r - p);
+  free(p);
+  if (w)
+    XFree(w);
+}
+// Return c's window to the root, as the save set would, and drop its frame.
+static void unframe(struct JBWMClient * c)
+{
+  Display * d = c->screen->xlib->display;
+  // Clients of other desktops stay hidden.
+  if (c->vdesk != c->screen->vdesk)
+    XUnmapWindow(d, c->window);
+  XReparentWindow(d, c->window, c->screen->xlib->root, c->size.x,
+    c->size.y);
+  XDestroyWindow(d, c->parent);
+}
+void jbwm_restart(Display * d, struct JBWMClient * head_client,
+  struct JBWMClient * current_client)
+{
+  struct JBWMClient * c;
+  int i;
+  JBWM_LOG("jbwm_restart");
+  for (i = ScreenCount(d); i--;) {
+    save_screen(d, i, head_client, current_client);
+    // Release the root, so the new process can redirect it at once.
+    XSelectInput(d, RootWindow(d, i), NoEventMask);
+  }
+  for (c = head_client; c; c = c->next)
+    unframe(c);
+  // Wait for all of the above, rather than race the new process.
+  XSync(d, false);
+  XCloseDisplay(d);
+  execvp(saved_argv[0], saved_argv);
+  jbwm_error(saved_argv[0]);
+}
+bool jbwm_restore_snapshot(struct JBWMScreen * s,
+  struct JBWMClient ** head_client, struct JBWMClient ** current_client)
+{
+  Display * d = s->xlib->display;
+  unsigned long n;
+  unsigned char * data;
+  long * p, * r, * end;
+  Window focused;
+  // Read and delete at once, so a later start does not reuse it.
+  if (XGetWindowProperty(d, s->xlib->root, get_atom(d), 0, LONG_MAX / 4,
+      true, XA_CARDINAL, &(Atom){0}, &(int){0}, &n, &(unsigned long){0},
+      &data) != Success || !data)
+    return false;
+  p = (long *)data;
+  focused = None;
+  if (n >= SNAPSHOT_HEADER && p[0] == SNAPSHOT_VERSION
+    && p[1] == SNAP_FIELDS) {
+    focused = p[2];
+    end = p + n - SNAP_FIELDS;
+    for (r = p + SNAPSHOT_HEADER; r <= end; r += SNAP_FIELDS)
+      jbwm_new_client_from_snapshot(unpack(s, r), head_client);
+  }
+  XFree(p);
+  if (focused) {
+    struct JBWMClient * c = jbwm_find_client(*head_client, focused);
+    // If hidden, it is focused when jbwm_set_vdesk shows its desktop.
+    if (c)
+      (c->vdesk == s->vdesk ? jbwm_select_client(c, current_client)
+       : jbwm_link_focus(c));
+  }
+  return true;
+}
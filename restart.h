@@ -0,0 +1,21 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_RESTART_H
+#define JBWM_RESTART_H
+#include <X11/Xlib.h>
+#include <stdbool.h>
+struct JBWMClient;
+struct JBWMScreen;
+// Keep argv for jbwm_restart, and restart on SIGHUP.
+void jbwm_set_up_restart(char ** argv) __attribute__((nonnull));
+bool jbwm_get_restart_requested(void);
+/* Save every client to a snapshot property on its root, then replace
+ * this process with a new jbwm, which adopts the clients from it.  */
+void jbwm_restart(Display * d, struct JBWMClient * head_client,
+  struct JBWMClient * current_client)
+__attribute__((nonnull(1),noreturn));
+/* Adopt the clients saved for s, if any, without querying the server
+ * for each.  Return true if a snapshot was found.  */
+bool jbwm_restore_snapshot(struct JBWMScreen * s,
+  struct JBWMClient ** head_client, struct JBWMClient ** current_client)
+__attribute__((nonnull));
+#endif//!JBWM_RESTART_H
@@ -0,0 +1,315 @@
+// Copyright 2020, Alisa Bedard
+/* Drive jbwm through the server in memory of fake_x.c, as another client
+ * would, and check the requests it sends for each operation against the
+ * counts below, those of a build without -DDEBUG.  A change meaning to
+ * alter them updates them too; any other difference is a regression,
+ * reported on stderr with exit status 1.  The first operation of each
+ * scenario only warms up, so the atoms, windows and GC values jbwm sets
+ * up once are not counted.  Each scenario is then repeated, default 1000
+ * times, and reported as a line of JSON:
+ *   map       a client maps a new window, which jbwm manages
+ *   move      a client asks to move its window, which jbwm keeps framed
+ *   maximize  _NET_WM_STATE maximizes a window both ways, then restores
+ *   desktop   _NET_CURRENT_DESKTOP switches between two desktops
+ *   snap      a window is snapped to its neighbour, with no requests  */
+#include "JBWMClient.h"
+#include "JBWMScreen.h"
+#include "atom.h"
+#include "client.h"
+#include "display.h"
+#include "events.h"
+#include "fake_x.h"
+#include "font.h"
+#include "jbwm.h"
+#include "keys.h"
+#include "snap.h"
+#include <X11/Xatom.h>
+#include <X11/Xproto.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+// The requests and round trips jbwm needs for one operation.
+struct Expected {
+  const char * scenario;
+  unsigned long requests, round_trips;
+};
+enum { WINDOWS = 8 }; // mapped before the scenarios after map
+static const struct Expected expected_map = {"map", 58, 12},
+  expected_move = {"move", 17, 1},
+  expected_maximize = {"maximize", 16, 0},
+  expected_desktop = {"desktop", 45, 5},
+  expected_snap = {"snap", 0, 0};
+struct Scenario {
+  struct JBWMScreen * screen;
+  struct JBWMClient * head_client, * current_client;
+  Display * wm, * app;
+  Window root;
+  bool failed;
+};
+static uint64_t get_time(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (uint64_t)t.tv_sec * 1000000000 + t.tv_nsec;
+}
+// Let jbwm handle every event waiting for it.
+static void dispatch(struct Scenario * s)
+{
+  while (XPending(s->wm)) {
+    XEvent ev;
+    XNextEvent(s->wm, &ev);
+    jbwm_handle_event(s->screen, &ev, &s->head_client,
+      &s->current_client);
+  }
+  XSync(s->app, True); // The client does not look at its events.
+}
+static void fail(struct Scenario * s, const char * scenario,
+  const char * what)
+{
+  fprintf(stderr, "%s: %s\n", scenario, what);
+  s->failed = true;
+}
+// Compare the counts since they were reset with e.
+static void check_counts(struct Scenario * s, const struct Expected * e)
+{
+  const unsigned long r = fake_x_get_requests(s->wm),
+        t = fake_x_get_round_trips(s->wm);
+  unsigned int i;
+  if (r != e->requests || t != e->round_trips) {
+    fprintf(stderr, "%s: %lu requests and %lu round trips, expected %lu"
+      " and %lu\n", e->scenario, r, t, e->requests, e->round_trips);
+    // By major opcode, as in X11/Xproto.h, to show what changed.
+    for (i = 0; i < 256; ++i)
+      if (fake_x_get_count(s->wm, i))
+        fprintf(stderr, "\topcode %u: %lu\n", i,
+          fake_x_get_count(s->wm, i));
+    s->failed = true;
+  }
+}
+static void report(const struct Expected * e, const unsigned int n,
+  const uint64_t ns)
+{
+  printf("{\"scenario\":\"%s\",\"operations\":%u,\"requests\":%lu,"
+    "\"round_trips\":%lu,\"ns_per_operation\":%.1f}\n", e->scenario, n,
+    e->requests, e->round_trips, (double)ns / n);
+  fflush(stdout);
+}
+static void send_message(struct Scenario * s, const Window w,
+  const Atom type, const long l0, const long l1, const long l2)
+{
+  XEvent e = {.xclient = {.type = ClientMessage, .window = w,
+    .message_type = type, .format = 32, .data.l = {l0, l1, l2}}};
+  XSendEvent(s->app, s->root, False,
+    SubstructureRedirectMask | SubstructureNotifyMask, &e);
+}
+static Window create_window(struct Scenario * s)
+{
+  static const char name[] = "scenario";
+  const Window w = XCreateSimpleWindow(s->app, s->root, 0, 0, 160, 120, 0,
+    0, 0);
+  XChangeProperty(s->app, w, XA_WM_NAME, XA_STRING, 8, PropModeReplace,
+    (const unsigned char *)name, sizeof(name) - 1);
+  return w;
+}
+// Map a new window and check that jbwm framed it.
+static Window map_window(struct Scenario * s)
+{
+  const Window w = create_window(s);
+  Window root, parent, * children;
+  unsigned int n;
+  XWindowAttributes a;
+  XMapWindow(s->app, w);
+  dispatch(s);
+  if (!jbwm_find_client(s->head_client, w))
+    fail(s, "map", "the window is not managed");
+  if (!XGetWindowAttributes(s->app, w, &a) || a.map_state != IsViewable)
+    fail(s, "map", "the window is not viewable");
+  if (XQueryTree(s->app, w, &root, &parent, &children, &n)) {
+    if (parent == root)
+      fail(s, "map", "the window is not framed");
+    XFree(children);
+  }
+  return w;
+}
+static void run_map(struct Scenario * s, const unsigned int n)
+{
+  Window * w = calloc(n + 1, sizeof(Window));
+  uint64_t ns = 0;
+  unsigned int i;
+  for (i = 0; i <= n; ++i) {
+    const Window c = create_window(s);
+    uint64_t begin;
+    XSync(s->app, True);
+    fake_x_reset_counts(s->wm);
+    XMapWindow(s->app, c);
+    begin = get_time();
+    dispatch(s);
+    if (i)
+      ns += get_time() - begin;
+    if (i == 1)
+      check_counts(s, &expected_map);
+    w[i] = c;
+  }
+  report(&expected_map, n, ns);
+  for (i = 0; i <= n; ++i)
+    XDestroyWindow(s->app, w[i]);
+  dispatch(s);
+  if (s->head_client)
+    fail(s, "map", "destroyed windows are still managed");
+  free(w);
+}
+static void run_move(struct Scenario * s, struct JBWMClient * c,
+  const unsigned int n)
+{
+  const union JBWMRectangle before = c->size;
+  uint64_t begin, ns = 0;
+  unsigned int i;
+  for (i = 0; i <= n; ++i) {
+    XWindowAttributes a;
+    fake_x_reset_counts(s->wm);
+    XMoveWindow(s->app, c->window, 100 + (i & 63), 200 + (i & 31));
+    begin = get_time();
+    dispatch(s);
+    if (i)
+      ns += get_time() - begin;
+    if (i != 1)
+      continue;
+    check_counts(s, &expected_move);
+    // jbwm puts the window back below its title bar, where it was.
+    if (memcmp(&c->size, &before, sizeof(before))
+      || !XGetWindowAttributes(s->app, c->window, &a) || a.x
+      || a.y != c->screen->font_height)
+      fail(s, "move", "the window left its frame");
+  }
+  report(&expected_move, n, ns);
+}
+static void run_maximize(struct Scenario * s, struct JBWMClient * c,
+  const unsigned int n)
+{
+  const union JBWMRectangle before = c->size;
+  uint64_t begin, ns = 0;
+  unsigned int i;
+  for (i = 0; i <= n; ++i) {
+    fake_x_reset_counts(s->wm);
+    send_message(s, c->window, jbwm_atoms[JBWM_NET_WM_STATE], 1,
+      jbwm_atoms[JBWM_NET_WM_STATE_MAXIMIZED_HORZ],
+      jbwm_atoms[JBWM_NET_WM_STATE_MAXIMIZED_VERT]);
+    begin = get_time();
+    dispatch(s);
+    if (i)
+      ns += get_time() - begin;
+    if (i == 1) {
+      check_counts(s, &expected_maximize);
+      if (!c->opt.max_horz || !c->opt.max_vert
+        || c->size.width <= before.width)
+        fail(s, "maximize", "the window is not maximized");
+    }
+    send_message(s, c->window, jbwm_atoms[JBWM_NET_WM_STATE], 0,
+      jbwm_atoms[JBWM_NET_WM_STATE_MAXIMIZED_HORZ],
+      jbwm_atoms[JBWM_NET_WM_STATE_MAXIMIZED_VERT]);
+    dispatch(s);
+    if (i == 1 && memcmp(&c->size, &before, sizeof(before)))
+      fail(s, "maximize", "the window is not restored");
+  }
+  report(&expected_maximize, n, ns);
+}
+// Switch between desktops 0 and 1, each holding half the windows.
+static void run_desktop(struct Scenario * s, const unsigned int n)
+{
+  const Atom current = jbwm_atoms[JBWM_NET_CURRENT_DESKTOP];
+  struct JBWMClient * c;
+  uint64_t begin, ns = 0;
+  unsigned int i;
+  for (c = s->head_client, i = 0; c; c = c->next, ++i)
+    if (i & 1)
+      send_message(s, c->window, jbwm_atoms[JBWM_NET_WM_DESKTOP], 1, 0, 0);
+  dispatch(s);
+  for (i = 0; i <= n; ++i) {
+    const uint8_t v = !s->screen->vdesk;
+    fake_x_reset_counts(s->wm);
+    send_message(s, s->root, current, v, 0, 0);
+    begin = get_time();
+    dispatch(s);
+    if (i)
+      ns += get_time() - begin;
+    if (i == 1) {
+      check_counts(s, &expected_desktop);
+      if (s->screen->vdesk != v)
+        fail(s, "desktop", "the desktop did not change");
+    }
+  }
+  if (s->screen->vdesk) { // Leave every window on the desktop shown.
+    send_message(s, s->root, current, 0, 0, 0);
+    dispatch(s);
+  }
+  report(&expected_desktop, n, ns);
+}
+// Snap c to the right of the next window on its desktop, each time.
+static void run_snap(struct Scenario * s, struct JBWMClient * c,
+  const unsigned int n)
+{
+  struct JBWMClient * o;
+  int16_t right;
+  uint64_t begin, ns = 0;
+  unsigned int i;
+  for (o = c->next; o && o->vdesk != c->vdesk; o = o->next)
+    ;
+  if (!o) {
+    fail(s, "snap", "there is no other window");
+    return;
+  }
+  right = o->size.x + o->size.width;
+  fake_x_reset_counts(s->wm);
+  begin = get_time();
+  for (i = 0; i < n; ++i) {
+    c->size.x = right + 3;
+    c->size.y = o->size.y;
+    jbwm_snap_client(c, &s->head_client);
+  }
+  ns = get_time() - begin;
+  check_counts(s, &expected_snap);
+  if (c->size.x != right)
+    fail(s, "snap", "the window did not snap to its neighbour");
+  report(&expected_snap, n, ns);
+}
+static void set_up(struct Scenario * s, struct JBWMScreen * screen)
+{
+  s->wm = jbwm_open_display();
+  jbwm_create_atoms(s->wm);
+  jbwm_open_font(s->wm);
+  jbwm_update_keys(s->wm);
+  jbwm_set_up_error_handler(&s->head_client, &s->current_client);
+  s->screen = screen;
+  jbwm_init_screens(s->wm, screen, &s->head_client, &s->current_client, 1);
+  s->app = XOpenDisplay(NULL);
+  s->root = DefaultRootWindow(s->app);
+  dispatch(s);
+}
+int main(int argc, char ** argv)
+{
+  struct Scenario s = {0};
+  struct JBWMScreen screen = {0};
+  struct JBWMClient * c;
+  unsigned int n = 1000, i;
+  int opt;
+  while ((opt = getopt(argc, argv, "n:")) != -1)
+    if (opt != 'n' || (n = strtoul(optarg, NULL, 10)) < 1) {
+      fprintf(stderr, "%s [-n OPERATIONS]\n", argv[0]);
+      return 1;
+    }
+  set_up(&s, &screen);
+  run_map(&s, n);
+  for (i = 0; i < WINDOWS; ++i)
+    map_window(&s);
+  // The client mapped last is at the head.
+  c = s.head_client;
+  run_move(&s, c, n);
+  run_maximize(&s, c, n);
+  run_desktop(&s, n);
+  run_snap(&s, c, n);
+  return s.failed;
+}
@@ -0,0 +1,39 @@
+// Copyright 2020, Alisa Bedard
+#include "screen.h"
+#include "JBWMScreen.h"
+#include <string.h>
+/* An open addressing table, kept at most half full so a lookup usually
+ * takes one probe.  Root ids need not be consecutive, so hash them.  */
+enum { SCREEN_TABLE_SIZE = 512 }; // Twice the most screens
+static struct {
+  Window root;
+  struct JBWMScreen * screen;
+} table[SCREEN_TABLE_SIZE];
+static struct JBWMScreen * first;
+__attribute__((const))
+static unsigned int hash(const Window root)
+{
+  return (root ^ (root >> 9) ^ (root >> 18)) & (SCREEN_TABLE_SIZE - 1);
+}
+void jbwm_set_screens(struct JBWMScreen * s, const uint8_t n)
+{
+  uint8_t i;
+  memset(table, 0, sizeof(table));
+  first = s;
+  for (i = 0; i < n; ++i) {
+    const Window r = s[i].xlib->root;
+    unsigned int h;
+    for (h = hash(r); table[h].root; h = (h + 1) & (SCREEN_TABLE_SIZE - 1))
+      ;
+    table[h].root = r;
+    table[h].screen = s + i;
+  }
+}
+struct JBWMScreen * jbwm_get_screen(const Window root)
+{
+  unsigned int h;
+  for (h = hash(root); table[h].root; h = (h + 1) & (SCREEN_TABLE_SIZE - 1))
+    if (table[h].root == root)
+      return table[h].screen;
+  return first;
+}
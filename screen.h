@@ -0,0 +1,13 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_SCREEN_H
+#define JBWM_SCREEN_H
+#include <X11/Xlib.h>
+#include <stdint.h>
+struct JBWMScreen;
+// Index the n screens of s by root window.
+void jbwm_set_screens(struct JBWMScreen * s, const uint8_t n)
+__attribute__((nonnull));
+// Return the screen whose root is root, or the first screen if none.
+struct JBWMScreen * jbwm_get_screen(const Window root)
+__attribute__((pure));
+#endif//!JBWM_SCREEN_H
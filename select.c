@@ -5,11 +5,13 @@
 #include "select.h"
 #include <X11/Xatom.h>
 #include <X11/Xlib.h>
+#include <stdbool.h>
 #include "client.h"
 #include "ewmh.h"
 #include "ewmh_state.h"
 #include "atom.h"
 #include "JBWMClient.h"
+#include "max.h"
 #include "util.h"
 #define WM_STATE(a) EWMH_ATOM(WM_STATE_##a)
 static inline jbwm_pixel_t get_bg(struct JBWMClient * c)
@@ -51,7 +53,26 @@ static void set_active_window_property(struct JBWMClient * c)
     jbwm_atoms[JBWM_NET_ACTIVE_WINDOW], XA_WINDOW, 32,
     PropModeReplace, (unsigned char *)&w, 1);
 }
-void jbwm_select_client(struct JBWMClient * target,
+void jbwm_unlink_focus(struct JBWMClient * c)
+{
+  if (c->focus_prev) {
+    if ((*c->focus_prev = c->focus_next))
+      c->focus_next->focus_prev = c->focus_prev;
+    c->focus_prev = NULL;
+  }
+}
+void jbwm_link_focus(struct JBWMClient * c)
+{
+  struct JBWMClient ** head = &c->screen->focus[c->vdesk];
+  jbwm_unlink_focus(c);
+  if ((c->focus_next = *head))
+    c->focus_next->focus_prev = &c->focus_next;
+  *head = c;
+  c->focus_prev = head;
+}
+// Set while cycling, so the focus list keeps its order until the end.
+static bool cycling;
+static void focus(struct JBWMClient * target,
   struct JBWMClient ** current_client)
 {
   struct JBWMClient * prev;
@@ -65,4 +86,30 @@ void jbwm_select_client(struct JBWMClient * target,
       set_state_not_focused(prev);
   }
 }
+void jbwm_select_client(struct JBWMClient * target,
+  struct JBWMClient ** current_client)
+{
+  cycling = false;
+  focus(target, current_client);
+  jbwm_link_focus(target);
+  jbwm_update_fullscreen_mode(target->screen);
+}
+struct JBWMClient * jbwm_cycle_focus(struct JBWMScreen * s,
+  struct JBWMClient ** current_client)
+{
+  struct JBWMClient * c = *current_client;
+  c = c && c->focus_prev && c->screen == s && c->vdesk == s->vdesk
+    && c->focus_next ? c->focus_next : s->focus[s->vdesk];
+  if (!c || c == *current_client)
+    return NULL;
+  cycling = true;
+  focus(c, current_client);
+  return c;
+}
+void jbwm_end_focus_cycle(struct JBWMClient ** current_client)
+{
+  if (cycling && *current_client)
+    jbwm_select_client(*current_client, current_client);
+  cycling = false;
+}
 
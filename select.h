@@ -5,7 +5,20 @@
 #ifndef JBWM_SELECT_H
 #define JBWM_SELECT_H
 struct JBWMClient;
+struct JBWMScreen;
 // Set client as that receiving focus
 void jbwm_select_client(struct JBWMClient * target,
   struct JBWMClient ** current_client);
+// Move c to the front of its desktop's focus list, linking it if needed.
+void jbwm_link_focus(struct JBWMClient * c) __attribute__((nonnull));
+void jbwm_unlink_focus(struct JBWMClient * c) __attribute__((nonnull));
+/* Focus the client after the current one in its desktop's focus list,
+ * leaving the list unchanged until jbwm_end_focus_cycle.  The first step
+ * reaches the previously focused client.  Return the client focused, or
+ * NULL if there is no other.  */
+struct JBWMClient * jbwm_cycle_focus(struct JBWMScreen * s,
+  struct JBWMClient ** current_client) __attribute__((nonnull));
+// Move the client chosen by cycling to the front of the focus list.
+void jbwm_end_focus_cycle(struct JBWMClient ** current_client)
+__attribute__((nonnull));
 #endif//!JBWM_SELECT_H
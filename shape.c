@@ -5,32 +5,108 @@
 #include "shape.h"
 #include <X11/extensions/shape.h>
 #include "JBWMClient.h"
+#include "ewmh.h"
 #include "log.h"
-// Declared with pure attribute, as value may not change between calls.
+#include "move_resize.h"
+#include "mwm.h"
+#include "title_bar.h"
+#include "transaction.h"
+int jbwm_get_shape_event(Display * d)
+{
+  static int event = -1;
+  static bool queried;
+  if (!queried) {
+    int e, error;
+    if (XShapeQueryExtension(d, &e, &error))
+      event = e + ShapeNotify;
+    queried = true;
+  }
+  return event;
+}
+// Store the bounding shape extents of c's window, returning if shaped.
+static bool query_shape(struct JBWMClient * c)
+{
+  int s, d, x, y;
+  unsigned int u, w, h;
+  if (!XShapeQueryExtents(c->screen->xlib->display, c->window, &s, &x, &y,
+      &w, &h, &d, &d, &d, &u, &u))
+    return false;
+  c->shape = (union JBWMRectangle){.x = x, .y = y, .width = w,
+    .height = h};
+  return s;
+}
+static void combine(struct JBWMClient * c)
+{
+  JBWM_LOG("XShapeCombineShape: %d", (int)c->window);
+  // The client sits at the frame origin, as shaped frames have no border.
+  XShapeCombineShape(c->screen->xlib->display, c->parent, ShapeBounding,
+    0, 0, c->window, ShapeBounding, ShapeSet);
+}
+// Return true if a window of size r would clip the shape extents s.
 __attribute__((pure))
-static bool is_shaped(Display * dpy, const Window win)
+static bool clips(const union JBWMRectangle * s,
+  const union JBWMRectangle * r)
 {
-  int s, d;
-  unsigned int u;
-  return XShapeQueryExtents(dpy, win, &s, &d, &d,
-    &u, &u, &d, &d, &d, &u, &u) && s;
+  return s->x < 0 || s->y < 0 || s->x + s->width > r->width
+    || s->y + s->height > r->height;
 }
+/* Called before c->committed is updated.  The effective shape only
+ * changes with the size when the extents do not fit within both the old
+ * and the new size, so skip the recombine otherwise.  */
 void jbwm_set_shape(struct JBWMClient * c)
 {
-  if(c->opt.shaped) {
-    JBWM_LOG("XShapeCombineShape: %d", (int)c->window);
-    Display * d = c->screen->xlib->display;
-    XFlush(d);
-    XShapeCombineShape(d, c->parent, ShapeBounding,
-      1, 1, c->window, ShapeBounding, ShapeSet);
-  }
+  if (c->opt.shaped && (clips(&c->shape, &c->committed)
+      || clips(&c->shape, &c->size)))
+    combine(c);
+}
+static void set_shaped_options(struct JBWMClientOptions * o)
+{
+  o->no_title_bar = o->shaped = true;
+  o->border = 0;
+}
+void jbwm_track_shape(struct JBWMClient * c)
+{
+  XShapeSelectInput(c->screen->xlib->display, c->window, ShapeNotifyMask);
 }
 void jbwm_new_shaped_client(struct JBWMClient * c)
 {
-  if (is_shaped(c->screen->xlib->display, c->window)) {
+  jbwm_track_shape(c);
+  if (query_shape(c)) {
     JBWM_LOG("Window %d is shaped", (int)c->window);
-    struct JBWMClientOptions * o = &c->opt;
-    o->no_title_bar = o->shaped = true;
-    o->border = 0;
+    set_shaped_options(&c->opt);
   }
 }
+// The client set or removed its shape after it was mapped.
+static void change_shaped(struct JBWMClient * c, const bool shaped)
+{
+  struct JBWMClientOptions * o = &c->opt;
+  Display * d = c->screen->xlib->display;
+  if (shaped) {
+    o->no_title_bar = true;
+    jbwm_update_title_bar(c); // removes the title bar, if there is one
+    set_shaped_options(o);
+  }
+  jbwm_begin(c);
+  if (!shaped) {
+    o->shaped = o->no_title_bar = false;
+    o->border = 1;
+    jbwm_handle_mwm_hints(c);
+    XShapeCombineMask(d, c->parent, ShapeBounding, 0, 0, None, ShapeSet);
+  }
+  XSetWindowBorderWidth(d, c->parent, o->fullscreen ? 0 : o->border);
+  jbwm_set_frame_extents(c);
+  jbwm_move_resize(c);
+  jbwm_commit(c);
+}
+void jbwm_handle_ShapeNotify(struct JBWMClient * c, XEvent * ev)
+{
+  XShapeEvent * e = (XShapeEvent *)ev;
+  if (e->kind != ShapeBounding || e->window != c->window)
+    return;
+  c->shape = (union JBWMRectangle){.x = e->x, .y = e->y,
+    .width = e->width, .height = e->height};
+  if ((bool)e->shaped != c->opt.shaped)
+    change_shaped(c, e->shaped);
+  if (c->opt.shaped)
+    combine(c);
+}
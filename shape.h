@@ -4,7 +4,15 @@
 // See README for license and other details.
 #ifndef JBWM_SHAPE_H
 #define JBWM_SHAPE_H
+#include <X11/Xlib.h>
 struct JBWMClient;
+// Return the ShapeNotify event type, or -1 without the SHAPE extension.
+int jbwm_get_shape_event(Display * d);
+// Track shape changes of c's window, whose shape is already known.
+void jbwm_track_shape(struct JBWMClient * c);
+// Track shape changes of c's window and adopt its current shape.
 void jbwm_new_shaped_client(struct JBWMClient * c);
+// Recombine the frame shape if a pending resize changes it.
 void jbwm_set_shape(struct JBWMClient * c);
+void jbwm_handle_ShapeNotify(struct JBWMClient * c, XEvent * ev);
 #endif//!JBWM_SHAPE_H
@@ -0,0 +1,77 @@
+// Copyright 2020, Alisa Bedard
+#include "size_hints.h"
+#include "JBWMClient.h"
+#include "macros.h"
+static struct JBWMSize get_size(const int w, const int h)
+{
+  return (struct JBWMSize){JB_MAX(w, 0), JB_MAX(h, 0)};
+}
+void jbwm_set_size_hints(struct JBWMClient * c, const XSizeHints * h)
+{
+  struct JBWMClientSizeHints * s = &c->hints;
+  const long f = h->flags;
+  *s = (struct JBWMClientSizeHints){.loaded = true,
+    .increment = {1, 1}};
+  // Each of the base and minimum sizes stands in for the other.
+  if (f & PBaseSize)
+    s->base = get_size(h->base_width, h->base_height);
+  else if (f & PMinSize)
+    s->base = get_size(h->min_width, h->min_height);
+  if (f & PMinSize)
+    s->min = get_size(h->min_width, h->min_height);
+  else
+    s->min = s->base;
+  if (f & PMaxSize)
+    s->max = get_size(h->max_width, h->max_height);
+  if ((f & PResizeInc) && h->width_inc > 0 && h->height_inc > 0)
+    s->increment = get_size(h->width_inc, h->height_inc);
+  if ((f & PAspect) && h->min_aspect.y > 0 && h->max_aspect.y > 0) {
+    s->min_aspect = get_size(h->min_aspect.x, h->min_aspect.y);
+    s->max_aspect = get_size(h->max_aspect.x, h->max_aspect.y);
+  }
+}
+void jbwm_invalidate_size_hints(struct JBWMClient * c)
+{
+  c->hints.loaded = false;
+}
+static struct JBWMClientSizeHints * get_hints(struct JBWMClient * c)
+{
+  if (!c->hints.loaded) {
+    XSizeHints h;
+    if (!XGetWMNormalHints(c->screen->xlib->display, c->window, &h,
+        &(long){0}))
+      h.flags = 0;
+    jbwm_set_size_hints(c, &h);
+  }
+  return &c->hints;
+}
+uint16_t jbwm_get_size_increment(struct JBWMClient * c,
+  const bool horizontal)
+{
+  const struct JBWMSize * i = &get_hints(c)->increment;
+  return horizontal ? i->width : i->height;
+}
+void jbwm_constrain_size(struct JBWMClient * c)
+{
+  const struct JBWMClientSizeHints * h = get_hints(c);
+  // Aspect and increments apply to the size beyond the base.
+  long w = JB_MAX(c->size.width - h->base.width, 0),
+       y = JB_MAX(c->size.height - h->base.height, 0);
+  if (h->max_aspect.height && w * h->max_aspect.height
+    > y * h->max_aspect.width)
+    w = y * h->max_aspect.width / h->max_aspect.height;
+  if (h->min_aspect.width && w * h->min_aspect.height
+    < y * h->min_aspect.width)
+    y = w * h->min_aspect.height / h->min_aspect.width;
+  w += h->base.width - w % h->increment.width;
+  y += h->base.height - y % h->increment.height;
+  w = JB_MAX(w, h->min.width);
+  y = JB_MAX(y, h->min.height);
+  if (h->max.width)
+    w = JB_MIN(w, h->max.width);
+  if (h->max.height)
+    y = JB_MIN(y, h->max.height);
+  // Avoid client crashes if the axis geometry is 0.
+  c->size.width = JB_MAX(w, 1);
+  c->size.height = JB_MAX(y, 1);
+}
@@ -0,0 +1,21 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_SIZE_HINTS_H
+#define JBWM_SIZE_HINTS_H
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <stdbool.h>
+#include <stdint.h>
+struct JBWMClient;
+// Cache h as c's size hints, for callers that have read them already.
+void jbwm_set_size_hints(struct JBWMClient * c, const XSizeHints * h)
+__attribute__((nonnull));
+// Drop c's cached size hints, so they are read again when next needed.
+void jbwm_invalidate_size_hints(struct JBWMClient * c)
+__attribute__((nonnull));
+// Return c's resize increment along one axis, at least 1.
+uint16_t jbwm_get_size_increment(struct JBWMClient * c,
+  const bool horizontal) __attribute__((nonnull));
+/* Bring c's size within its hints: aspect ratio, then increments, then
+ * the minimum and maximum.  The position is left alone.  */
+void jbwm_constrain_size(struct JBWMClient * c) __attribute__((nonnull));
+#endif//!JBWM_SIZE_HINTS_H
@@ -6,8 +6,8 @@
 /***/
 #include "config.h"
 #include "JBWMClient.h"
+#include "JBWMScreen.h"
 #include "JBWMPoint.h"
-#include "JBWMSize.h"
 #include <stdlib.h>
 /***/
 #ifdef JBWM_DEBUG_ABSMIN
@@ -47,13 +47,16 @@ void jbwm_snap_border(struct JBWMClient * c)
 {
   struct JBWMScreen *scr = c->screen;
   union JBWMRectangle * g = &(c->size);
-  const struct JBWMSize s = {scr->xlib->width,
-    scr->xlib->height};
   const uint8_t b = c->opt.border << 1;
-  /*  snap to screen border */
-  g->x=sborderdir(g->x,0,g->width-s.width+b);
-  g->y=sborderdir(g->y,(c->opt.no_title_bar^1)*-scr->font_height,
-    g->height - s.height + b);
+  const int16_t tb = (c->opt.no_title_bar^1) * scr->font_height;
+  uint8_t i;
+  /*  snap to the edges of every monitor, the screen border among them */
+  for (i = 0; i < scr->monitor_count; ++i) {
+    const union JBWMRectangle * m = scr->monitors + i;
+    g->x=sborderdir(g->x, -m->x, g->width - (m->x + m->width) + b);
+    g->y=sborderdir(g->y, -(m->y + tb),
+      g->height - (m->y + m->height) + b);
+  }
 }
 /* Definition of this as an inline function guarantees no side-effects
  * and minimizes over-expansion (the full expansion of jbwm_snap_dim
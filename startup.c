@@ -0,0 +1,40 @@
+// Copyright 2020, Alisa Bedard
+#include "startup.h"
+#include "command_line.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+static uint64_t phase_ns[JBWM_PHASE_COUNT], last_ns;
+static uint64_t get_time(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (uint64_t)t.tv_sec * 1000000000 + t.tv_nsec;
+}
+void jbwm_begin_startup(void)
+{
+  last_ns = get_time();
+}
+void jbwm_end_phase(const enum JBWMStartupPhase p)
+{
+  const uint64_t t = get_time();
+  phase_ns[p] += t - last_ns;
+  last_ns = t;
+}
+void jbwm_report_startup(Display * d)
+{
+  static const char * const names[JBWM_PHASE_COUNT] = {"display",
+    "atoms", "font", "colors", "grabs", "adoption", "ewmh"};
+  uint64_t total = 0;
+  uint8_t i;
+  if (!jbwm_get_startup_timing())
+    return;
+  // Replies were collected as needed, but the rest is still in flight.
+  XSync(d, false);
+  jbwm_end_phase(JBWM_PHASE_EWMH);
+  for (i = 0; i < JBWM_PHASE_COUNT; ++i) {
+    fprintf(stderr, "%-9s %8.3f ms\n", names[i], phase_ns[i] / 1e6);
+    total += phase_ns[i];
+  }
+  fprintf(stderr, "%-9s %8.3f ms\n", "total", total / 1e6);
+}
@@ -0,0 +1,13 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_STARTUP_H
+#define JBWM_STARTUP_H
+#include "JBWMStartupPhase.h"
+#include <X11/Xlib.h>
+// Start the clock for the first phase.
+void jbwm_begin_startup(void);
+/* Charge the time since the previous phase ended to p.  Phases that recur
+ * per screen accumulate.  */
+void jbwm_end_phase(const enum JBWMStartupPhase p);
+// With -T, wait for the server to catch up, then print each phase.
+void jbwm_report_startup(Display * d) __attribute__((nonnull));
+#endif//!JBWM_STARTUP_H
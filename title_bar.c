@@ -10,6 +10,7 @@
 #include "font.h"
 #include "atom.h"
 #include "move_resize.h"
+#include "transaction.h"
 #include "util.h"
 #include "wm_state.h"
 #include <stdlib.h>
@@ -38,54 +39,67 @@ static inline bool can_shade(struct JBWMClient * c)
 void jbwm_toggle_shade(struct JBWMClient * c)
 {
   if (can_shade(c)){
-    Display *d;
     const bool s = c->opt.shaded = !c->opt.shaded;
     const int8_t state = (s ? set_shaded : set_not_shaded)(c);
-    d=c->screen->xlib->display;
-    (state == IconicState ? jbwm_ewmh_add_state : jbwm_ewmh_remove_state)
-    (d, c->window, jbwm_atoms[JBWM_NET_WM_STATE_SHADED]);
+    jbwm_begin(c);
+    jbwm_ewmh_set_state(c, JBWM_NET_WM_STATE_SHADED, s);
     jbwm_move_resize(c);
+    jbwm_commit(c);
     jbwm_set_wm_state(c, state);
   }
 }
-static inline uint16_t mv(Display * const d, Window const w, 
-  uint8_t const font_height, uint16_t x) {
-  if (w){
-    XMoveWindow(d, w, x -= font_height, 0);
-  }
-  return x;
-}
-// Return of width allows chain-calling
-static uint16_t move_buttons(Display * d,
-  struct JBWMClientTitleBar * t,
-  const uint16_t width, uint8_t const font_height)
-{
-  mv(d, t->stick, font_height,
-    mv(d, t->shade, font_height,
-      mv(d, t->resize, font_height, width)));
-  return width;
-}
 static inline Window get_win(Display * d, const Window p,
   const jbwm_pixel_t bg, uint8_t const font_height)
 {
   return XCreateSimpleWindow(d, p, 0, 0, font_height, font_height, 0, 0, bg);
 }
-static void add_buttons(struct JBWMClient * c,
-  const struct JBWMPixels * p, const Window t)
+/* Close sits at the left, the rest pack in from the right.  Buttons
+ * disabled by the client's options get -1.  Shared by drawing and hit
+ * testing so the two always agree.  */
+static void get_buttons(struct JBWMClient * c,
+  int16_t x[JBWM_BUTTON_NONE])
+{
+  const struct JBWMClientOptions * o = &c->opt;
+  const int16_t h = c->screen->font_height;
+  int16_t r = c->size.width;
+  x[JBWM_BUTTON_CLOSE] = o->no_close ? -1 : 0;
+  x[JBWM_BUTTON_RESIZE] = o->no_resize ? -1 : (r -= h);
+  x[JBWM_BUTTON_SHADE] = o->no_shade ? -1 : (r -= h);
+  x[JBWM_BUTTON_STICK] = r - h;
+}
+enum JBWMTitleBarButton jbwm_get_title_bar_button(struct JBWMClient * c,
+  const int x)
+{
+  int16_t b[JBWM_BUTTON_NONE];
+  uint8_t i;
+  get_buttons(c, b);
+  for (i = 0; i < JBWM_BUTTON_NONE; ++i)
+    if (b[i] >= 0 && x >= b[i] && x < b[i] + c->screen->font_height)
+      return i;
+  return JBWM_BUTTON_NONE;
+}
+static void draw_buttons(struct JBWMClient * c)
 {
-  struct JBWMClientOptions * o = &c->opt;
-  Display * d = c->screen->xlib->display;
-  uint8_t const h = c->screen->font_height;
-  c->tb.close = o->no_close ? 0 : get_win(d, t, p->close, h);
-  c->tb.resize = o->no_resize ? 0: get_win(d, t, p->resize, h);
-  c->tb.shade = o->no_shade ? 0 : get_win(d, t, p->shade, h);
-  c->tb.stick = get_win(d, t, p->stick, h);
+  struct JBWMScreen * s = c->screen;
+  const struct JBWMPixels * p = &s->pixels;
+  const jbwm_pixel_t pixel[JBWM_BUTTON_NONE] = {p->close, p->resize,
+    p->shade, p->stick};
+  Display * d = s->xlib->display;
+  const uint8_t h = s->font_height;
+  int16_t b[JBWM_BUTTON_NONE];
+  uint8_t i;
+  get_buttons(c, b);
+  for (i = 0; i < JBWM_BUTTON_NONE; ++i)
+    if (b[i] >= 0) {
+      XSetForeground(d, s->gc, pixel[i]);
+      XFillRectangle(d, c->tb.win, s->gc, b[i], 0, h, h);
+    }
+  XSetForeground(d, s->gc, p->fg);
 }
 static void configure_title_bar(Display * d, const Window t)
 {
   XSelectInput(d, t, ExposureMask);
   XMapRaised(d, t);
-  XMapSubwindows(d, t);
   jbwm_grab_button(d, t, None);
 }
 static Window new_title_bar(struct JBWMClient * c)
@@ -95,7 +109,6 @@ static Window new_title_bar(struct JBWMClient * c)
   Display * d = s->xlib->display;
   const Window t = c->tb.win = get_win(d, c->parent, p->bg,
     s->font_height);
-  add_buttons(c, p, t);
   configure_title_bar(d, t);
   return t;
 }
@@ -104,15 +117,21 @@ static inline char * jbwm_get_title(Display * d, const Window w)
 {
   return jbwm_get_property(d, w, XA_WM_NAME, &(uint16_t){0});
 }
+void jbwm_fetch_title(struct JBWMClient * c)
+{
+  jbwm_set_title(c, jbwm_get_title(c->screen->xlib->display, c->window));
+}
+void jbwm_set_title(struct JBWMClient * c, char * title)
+{
+  if (c->title)
+    XFree(c->title);
+  c->title = title;
+}
 static void draw_title(struct JBWMClient * c)
 {
-  char *name;
-  name = jbwm_get_title(c->screen->xlib->display, c->window);
-  if (name) {
+  if (c->title)
     jbwm_draw_string(c->screen, c->tb.win, c->screen->font_height+4,
-      jbwm_get_font_ascent(), name, strlen(name));
-    XFree(name);
-  }
+      jbwm_get_font_ascent(), c->title, strlen(c->title));
 }
 static void remove_title_bar(struct JBWMClient * c)
 {
@@ -120,25 +139,19 @@ static void remove_title_bar(struct JBWMClient * c)
   XDestroyWindow(c->screen->xlib->display, c->tb.win);
   c->tb.win = 0;
 }
-static inline void resize_title_bar(Display * d, const Window win,
-  struct JBWMClientTitleBar * tb, const uint16_t new_width,
-  uint8_t const font_height) {
-  // Expand/Contract the title bar width as necessary:
-  if (tb)
-    XResizeWindow(d, win, move_buttons(d, tb, new_width, font_height),
-      font_height);
-#ifdef DEBUG
-  else
-    abort();
-#endif//DEBUG
-}
 void jbwm_update_title_bar(struct JBWMClient * c)
 {
+  if (c->transaction.depth) {
+    c->transaction.title = true; // drawn by jbwm_commit
+    return;
+  }
+  c->transaction.title = false;
   if (!c->opt.shaped){
     Window w;
     w = c->tb.win;
-    if (c->opt.fullscreen && w) {
-      remove_title_bar(c);
+    if (c->opt.fullscreen || c->opt.no_title_bar) {
+      if (w)
+        remove_title_bar(c);
     }else{
       if (!w)
         w = new_title_bar(c);
@@ -146,12 +159,12 @@ void jbwm_update_title_bar(struct JBWMClient * c)
         Display *d;
         struct JBWMScreen *s = c->screen;
         d = s->xlib->display;
-        resize_title_bar(d, w, &c->tb, c->size.width,s->font_height);
+        XResizeWindow(d, w, c->size.width, s->font_height);
         XClearWindow(d, w);
       }
+      // The title goes first so the buttons on the right cover it.
       draw_title(c);
-      if (c->opt.no_title_bar)
-        remove_title_bar(c);
+      draw_buttons(c);
     }
   }
 }
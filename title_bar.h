@@ -4,7 +4,16 @@
 // See README for license and other details.
 #ifndef JBWM_TITLE_BAR_H
 #define JBWM_TITLE_BAR_H
+#include "JBWMTitleBarButton.h"
 struct JBWMClient;
+// Return the button drawn at x in the title bar of c.
+enum JBWMTitleBarButton jbwm_get_title_bar_button(struct JBWMClient * c,
+  const int x);
+/* Read the WM_NAME of c again.  It is kept, so redrawing the title bar
+ * does not need to ask for it.  */
+void jbwm_fetch_title(struct JBWMClient * c);
+// Keep title, as read from WM_NAME, for c.
+void jbwm_set_title(struct JBWMClient * c, char * title);
 void jbwm_toggle_shade(struct JBWMClient * c);
 void jbwm_update_title_bar(struct JBWMClient * c);
 #endif /* JBWM_TITLE_BAR_H */
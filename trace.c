@@ -0,0 +1,184 @@
+// Copyright 2020, Alisa Bedard
+#include "trace.h"
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+enum { TRACE_SIZE = 1024 }; // a power of two
+/* Only the event loop writes.  Each slot carries a sequence, odd while it
+ * is being written, so a reader copies a slot and keeps the copy only if
+ * the sequence is even and unchanged afterwards.  Nothing ever waits.  */
+struct TraceEntry {
+  uint64_t sequence, begin, end; // times in ns
+  unsigned long serial, requests;
+  Window window;
+  int type;
+  enum JBWMHandler handler;
+};
+static struct TraceEntry ring[TRACE_SIZE];
+static uint64_t head; // index of the next entry
+static struct TraceEntry pending;
+static int dump_pipe[2] = {-1, -1};
+static uint64_t get_time(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (uint64_t)t.tv_sec * 1000000000 + t.tv_nsec;
+}
+void jbwm_trace_begin(XEvent * ev)
+{
+  pending.begin = get_time();
+  pending.serial = ev->xany.serial;
+  pending.window = ev->xany.window;
+  pending.type = ev->type;
+  pending.requests = NextRequest(ev->xany.display);
+}
+void jbwm_trace_end(Display * d, const enum JBWMHandler handler)
+{
+  const uint64_t h = head;
+  struct TraceEntry * e = ring + (h & (TRACE_SIZE - 1));
+  __atomic_store_n(&e->sequence, (h << 1) + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  e->begin = pending.begin;
+  e->end = get_time();
+  e->serial = pending.serial;
+  e->requests = NextRequest(d) - pending.requests;
+  e->window = pending.window;
+  e->type = pending.type;
+  e->handler = handler;
+  __atomic_store_n(&e->sequence, (h << 1) + 2, __ATOMIC_RELEASE);
+  __atomic_store_n(&head, h + 1, __ATOMIC_RELEASE);
+}
+// Copy entry i out of the ring, returning false if it was overwritten.
+static bool read_entry(const uint64_t i, struct TraceEntry * out)
+{
+  struct TraceEntry * e = ring + (i & (TRACE_SIZE - 1));
+  const uint64_t s = __atomic_load_n(&e->sequence, __ATOMIC_ACQUIRE);
+  memcpy(out, e, sizeof(*out));
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  return s == (i << 1) + 2
+    && __atomic_load_n(&e->sequence, __ATOMIC_RELAXED) == s;
+}
+static const char * get_name(const int type)
+{
+#define N(t) [t] = #t
+  static const char * const names[LASTEvent] = {N(KeyPress),
+    N(KeyRelease), N(ButtonPress), N(ButtonRelease), N(MotionNotify),
+    N(EnterNotify), N(LeaveNotify), N(FocusIn), N(FocusOut),
+    N(KeymapNotify), N(Expose), N(GraphicsExpose), N(NoExpose),
+    N(VisibilityNotify), N(CreateNotify), N(DestroyNotify),
+    N(UnmapNotify), N(MapNotify), N(MapRequest), N(ReparentNotify),
+    N(ConfigureNotify), N(ConfigureRequest), N(GravityNotify),
+    N(ResizeRequest), N(CirculateNotify), N(CirculateRequest),
+    N(PropertyNotify), N(SelectionClear), N(SelectionRequest),
+    N(SelectionNotify), N(ColormapNotify), N(ClientMessage),
+    N(MappingNotify), N(GenericEvent)};
+#undef N
+  return type >= 0 && type < LASTEvent && names[type] ? names[type]
+    : "Extension";
+}
+static const char * get_handler_name(const enum JBWMHandler h)
+{
+#define N(h, f) [JBWM_HANDLER_##h] = #f
+  static const char * const names[] = {N(NONE, none),
+    N(CONFIGURE_NOTIFY, jbwm_handle_ConfigureNotify),
+    N(CONFIGURE_REQUEST, jbwm_handle_ConfigureRequest),
+    N(KEY_EVENT, jbwm_handle_key_event),
+    N(KEY_RELEASE, jbwm_handle_key_release),
+    N(BUTTON_EVENT, jbwm_handle_button_event),
+    N(ENTER_NOTIFY, jbwm_handle_EnterNotify),
+    N(EXPOSE, jbwm_handle_Expose),
+    N(CLIENT_LIST, client_list_stale),
+    N(CLIENT_FREE, jbwm_client_free),
+    N(MAP_REQUEST, jbwm_handle_MapRequest),
+    N(PROPERTY_NOTIFY, jbwm_handle_PropertyNotify),
+    N(COLORMAP_NOTIFY, jbwm_handle_ColormapNotify),
+    N(CLIENT_MESSAGE, jbwm_ewmh_handle_client_message),
+    N(MAPPING_NOTIFY, jbwm_handle_MappingNotify),
+    N(SHAPE_NOTIFY, jbwm_handle_ShapeNotify),
+    N(MONITOR_EVENT, jbwm_handle_monitor_event)};
+#undef N
+  return (unsigned int)h < sizeof(names) / sizeof(*names) && names[h]
+    ? names[h] : "unknown";
+}
+void jbwm_trace_write(FILE * f)
+{
+  const uint64_t h = __atomic_load_n(&head, __ATOMIC_ACQUIRE);
+  const int pid = getpid();
+  uint64_t i;
+  const char * separator = "";
+  fputs("{\"traceEvents\":[", f);
+  for (i = h > TRACE_SIZE ? h - TRACE_SIZE : 0; i < h; ++i) {
+    struct TraceEntry e;
+    const char * handler;
+    if (!read_entry(i, &e))
+      continue;
+    handler = get_handler_name(e.handler);
+    fprintf(f, "%s\n{\"name\":\"%s %s\",\"ph\":\"X\",\"pid\":%d,"
+      "\"tid\":1,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"window\":%lu,"
+      "\"serial\":%lu,\"requests\":%lu,\"handler\":\"%s\"}}", separator,
+      get_name(e.type), handler, pid, e.begin / 1000.0,
+      (e.end - e.begin) / 1000.0, (unsigned long)e.window, e.serial,
+      e.requests, handler);
+    separator = ",";
+  }
+  fputs("\n]}\n", f);
+}
+static void dump(void)
+{
+  char path[PATH_MAX];
+  const char * dir = getenv("TMPDIR");
+  int fd;
+  snprintf(path, sizeof(path), "%s/jbwm-trace-%d.json", dir ? dir : "/tmp",
+    (int)getpid());
+  fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_NOFOLLOW | O_CLOEXEC,
+    0600);
+  if (fd >= 0) {
+    FILE * f = fdopen(fd, "w");
+    if (f) {
+      jbwm_trace_write(f);
+      fclose(f);
+    } else
+      close(fd);
+  }
+}
+static void * dumper(void * arg __attribute__((unused)))
+{
+  char c;
+  while (read(dump_pipe[0], &c, 1) == 1)
+    dump();
+  return NULL;
+}
+static void handle_usr1(int sig __attribute__((unused)))
+{
+  // Only write is safe here, so the dumper thread does the rest.
+  if (write(dump_pipe[1], "", 1) < 0)
+    return;
+}
+void jbwm_set_up_trace(void)
+{
+  struct sigaction a;
+  pthread_t t;
+  sigset_t all, old;
+  if (pipe(dump_pipe))
+    return;
+  fcntl(dump_pipe[0], F_SETFD, FD_CLOEXEC);
+  fcntl(dump_pipe[1], F_SETFD, FD_CLOEXEC);
+  fcntl(dump_pipe[1], F_SETFL, O_NONBLOCK);
+  // Leave the signal to the event loop's thread, not the dumper.
+  sigfillset(&all);
+  pthread_sigmask(SIG_SETMASK, &all, &old);
+  if (!pthread_create(&t, NULL, dumper, NULL))
+    pthread_detach(t);
+  pthread_sigmask(SIG_SETMASK, &old, NULL);
+  memset(&a, 0, sizeof(a));
+  a.sa_handler = handle_usr1;
+  a.sa_flags = SA_RESTART;
+  sigaction(SIGUSR1, &a, NULL);
+}
@@ -0,0 +1,18 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_TRACE_H
+#define JBWM_TRACE_H
+#include "JBWMHandler.h"
+#include <X11/Xlib.h>
+#include <stdio.h>
+/* Every event handled is recorded into a fixed ring in memory: its type,
+ * window and serial, the handler which ran, when handling began and
+ * ended, and how many requests it sent.  Recording is a few stores, so it
+ * is always on.  SIGUSR1 writes the ring out as Chrome trace JSON from a
+ * thread of its own.  */
+void jbwm_set_up_trace(void);
+void jbwm_trace_begin(XEvent * ev) __attribute__((nonnull));
+void jbwm_trace_end(Display * d, const enum JBWMHandler handler)
+__attribute__((nonnull));
+// Write what the ring holds as Chrome trace JSON.  Safe from any thread.
+void jbwm_trace_write(FILE * f) __attribute__((nonnull));
+#endif//!JBWM_TRACE_H
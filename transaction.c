@@ -0,0 +1,24 @@
+// Copyright 2020, Alisa Bedard
+#include "transaction.h"
+#include "JBWMClient.h"
+#include "ewmh_state.h"
+#include "move_resize.h"
+#include "title_bar.h"
+void jbwm_begin(struct JBWMClient * c)
+{
+  ++c->transaction.depth;
+}
+void jbwm_commit(struct JBWMClient * c)
+{
+  struct JBWMClientTransaction * t = &c->transaction;
+  if (t->depth && --t->depth)
+    return; // still nested
+  jbwm_ewmh_flush_state(c);
+  if (t->geometry) {
+    t->geometry = false;
+    // This also redraws the title bar if its width changed.
+    jbwm_move_resize(c);
+  }
+  if (t->title)
+    jbwm_update_title_bar(c);
+}
@@ -0,0 +1,10 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_TRANSACTION_H
+#define JBWM_TRANSACTION_H
+struct JBWMClient;
+/* Defer geometry, title bar and _NET_WM_STATE updates for c until the
+ * matching jbwm_commit.  Transactions may nest; only the outermost
+ * commit flushes, so compound operations reach the server once.  */
+void jbwm_begin(struct JBWMClient * c) __attribute__((nonnull));
+void jbwm_commit(struct JBWMClient * c) __attribute__((nonnull));
+#endif//!JBWM_TRANSACTION_H
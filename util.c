@@ -3,19 +3,63 @@
 // Copyright 1999-2015, Ciaran Anscomb <evilwm@6809.org.uk>
 // See README for license and other details.
 #include "util.h"
+#include <ctype.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 void jbwm_error(const char * msg)
 {
   perror(msg);
   exit(1);
 }
+/* Parse "#rgb" through "#rrrrggggbbbb" into 16 bit components, as
+ * XParseColor does.  */
+static bool parse_hex(const char * name, unsigned short * rgb)
+{
+  size_t len, n;
+  uint8_t i, j;
+  if (*name++ != '#')
+    return false;
+  len = strlen(name);
+  n = len / 3;
+  if (!n || len % 3 || n > 4)
+    return false;
+  for (i = 0; i < 3; ++i) {
+    unsigned int v = 0;
+    for (j = 0; j < n; ++j) {
+      const int c = tolower((unsigned char)*name++);
+      if (!isxdigit(c))
+        return false;
+      v = v << 4 | (isdigit(c) ? c - '0' : c - 'a' + 10);
+    }
+    rgb[i] = v << (16 - (n << 2));
+  }
+  return true;
+}
+// Keep the top bits of v, placed under mask, as the server would.
+static unsigned long get_component(const unsigned short v,
+  unsigned long mask)
+{
+  uint8_t shift = 0, bits = 0;
+  for (; mask && !(mask & 1); mask >>= 1)
+    ++shift;
+  for (; mask & 1; mask >>= 1)
+    ++bits;
+  return bits ? (unsigned long)(v >> (16 - bits)) << shift : 0;
+}
 jbwm_pixel_t jbwm_get_pixel(Display * dpy,
   const uint8_t screen, const char * name)
 {
   jbwm_pixel_t r;
-  if (name) { // sanitize input to avoid segfault
+  Visual * v = DefaultVisual(dpy, screen);
+  unsigned short rgb[3];
+  if (name && v->class == TrueColor && parse_hex(name, rgb))
+    // A TrueColor pixel is its value, so no round trip is needed.
+    r = get_component(rgb[0], v->red_mask)
+      | get_component(rgb[1], v->green_mask)
+      | get_component(rgb[2], v->blue_mask);
+  else if (name) { // sanitize input to avoid segfault
     XColor c, d;
     XAllocNamedColor(dpy, DefaultColormap(dpy, screen),
       name, &c, &d);
@@ -29,9 +73,13 @@ void *jbwm_get_property(Display * dpy, Window w,
 {
   unsigned char * value;
   long unsigned int n;
-  XGetWindowProperty(dpy, w, property, 0, 1024, false,
+  // Fails if w was destroyed since the property was asked for.
+  if (XGetWindowProperty(dpy, w, property, 0, 1024, false,
     AnyPropertyType, &property, &(int){0}, &n,
-    &(unsigned long){0}, &value);
+    &(unsigned long){0}, &value) != Success) {
+    *num_items = 0;
+    return NULL;
+  }
   if (property == None) {
     // Requested property not found
     XFree(value);
@@ -5,55 +5,99 @@
 #include "vdesk.h"
 #include "client.h"
 #include "config.h"
+#include "crossing.h"
 #include "draw.h"
 #include "ewmh.h"
 #include "font.h"
 #include "log.h"
 #include "atom.h"
+#include "max.h"
 #include "JBWMClient.h"
 #include "JBWMScreen.h"
+#include "select.h"
 #include "util.h"
 #include <X11/Xatom.h> // keep
-#include <assert.h>
-#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <sys/select.h>
-#include <unistd.h>
+#include <time.h>
 #ifdef JBWM_USE_XOSD
 #include <xosd.h>
 #endif//JBWM_USE_XOSD
-static void check_visibility(struct JBWMClient * c,
+/* Only the outgoing and incoming desktops' clients change visibility.
+ * Map the incoming ones first so the root is not exposed in between,
+ * and grab the server so the switch appears at once.  Return the client
+ * last focused on the incoming desktop.  */
+static struct JBWMClient * switch_desktop(struct JBWMScreen * s,
   const uint8_t v)
 {
-  if (c) {
-    if (c->vdesk == v || c->opt.sticky) {
-      // allow moving windows by sticking
-      c->vdesk = v;
-      jbwm_restore_client(c);
-    } else
-      jbwm_hide_client(c);
-    check_visibility(c->next, v);
+  struct JBWMClient * c, * const last = s->focus[v];
+  Display * d = s->xlib->display;
+  XGrabServer(d);
+  for (c = s->desktops[v]; c; c = c->desktop_next)
+    jbwm_restore_client(c);
+  for (c = s->desktops[s->vdesk]; c; c = c->desktop_next)
+    jbwm_hide_client(c);
+  XUngrabServer(d);
+  // Sticky clients stay mapped, and belong to whichever desktop is shown.
+  for (c = s->sticky; c; c = c->desktop_next) {
+    c->vdesk = v;
+    jbwm_link_focus(c);
   }
+  return last;
 }
 #ifndef JBWM_USE_XOSD
-static void *delayed_clear_thread(void *data) {
-  Display *d;
-  struct JBWMScreen * s = (struct JBWMScreen *)data;
-  d=s->xlib->display;
-  JBWM_LOG("pausing");
-  sleep(1);
-  XClearWindow(d, s->xlib->root);
-  XFlush(d); // must run before thread terminates
-  JBWM_LOG("window cleared");
-  return NULL;
+enum { OSD_BORDER = 4, OSD_TIMEOUT_MS = 1000 };
+// The screen showing the desktop indicator, and when to hide it.
+static struct JBWMScreen * osd_screen;
+static struct timespec osd_deadline;
+// Exposures are selected, as the label is redrawn when uncovered.
+static Window new_osd(struct JBWMScreen * s)
+{
+  return XCreateWindow(s->xlib->display, s->xlib->root, OSD_BORDER,
+    OSD_BORDER, 1, 1, 0, CopyFromParent, CopyFromParent, CopyFromParent,
+    CWOverrideRedirect | CWBackPixel | CWEventMask,
+    &(XSetWindowAttributes){.override_redirect = true,
+    .background_pixel = s->pixels.bg, .event_mask = ExposureMask});
+}
+// Draw the number of s's desktop into s's indicator.
+static void draw_osd(struct JBWMScreen * s)
+{
+  char buf[4]; // accomodate up to "255", plus '-', plus NUL
+  const uint8_t nul_index = snprintf(buf, sizeof(buf), "%d", s->vdesk);
+  XClearWindow(s->xlib->display, s->osd);
+  jbwm_draw_string(s, s->osd, OSD_BORDER,
+    OSD_BORDER + jbwm_get_font_ascent(), buf, nul_index);
 }
-static void delayed_clear(struct JBWMScreen *s){
-  pthread_t thread;
-  int r;
-  r = pthread_create(&thread, NULL, delayed_clear_thread, (void*)s);
-  assert(!r);
-  JBWM_LOG("thread launched");
+static void schedule_hide(struct JBWMScreen * s)
+{
+  if (osd_screen && osd_screen != s)
+    jbwm_hide_osd();
+  osd_screen = s;
+  clock_gettime(CLOCK_MONOTONIC, &osd_deadline);
+  osd_deadline.tv_sec += OSD_TIMEOUT_MS / 1000;
+}
+int jbwm_get_osd_timeout(void)
+{
+  struct timespec t;
+  long ms;
+  if (!osd_screen)
+    return -1;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  ms = (osd_deadline.tv_sec - t.tv_sec) * 1000
+    + (osd_deadline.tv_nsec - t.tv_nsec) / 1000000;
+  return ms > 0 ? ms : 0;
+}
+void jbwm_expose_osd(const Window w)
+{
+  if (osd_screen && osd_screen->osd == w)
+    draw_osd(osd_screen);
+}
+void jbwm_hide_osd(void)
+{
+  if (osd_screen) {
+    XUnmapWindow(osd_screen->xlib->display, osd_screen->osd);
+    osd_screen = NULL;
+  }
 }
 #endif//!JBWM_USE_XOSD
 #ifdef JBWM_USE_XOSD
@@ -82,26 +126,38 @@ static void show_desktop(struct JBWMScreen *s){
   snprintf(buf, sizeof(buf), "%d", s->vdesk);
   xosd_display(osd, 0, XOSD_string, buf);
 #else//!JBWM_USE_XOSD
-  enum { BORDER = 4 };
+  /* Draw into a small window of our own, so neither the root window
+   * nor anything above it needs to be repainted.  */
   Display *d;
   char buf[4]; // accomodate up to "255", plus '-', plus NUL
   uint8_t nul_index;
-  Window const r = s->xlib->root;
   d=s->xlib->display;
-  XClearWindow(d, r);
+  if (!s->osd)
+    s->osd = new_osd(s);
   nul_index = snprintf(buf, sizeof(buf), "%d", s->vdesk);
-  jbwm_draw_string(s, r, BORDER, BORDER+jbwm_get_font_ascent(),
-    buf, nul_index);
-  delayed_clear(s);
+  XResizeWindow(d, s->osd, jbwm_get_text_width(d, buf, nul_index)
+    + (OSD_BORDER << 1), s->font_height + (OSD_BORDER << 1));
+  XMapRaised(d, s->osd);
+  draw_osd(s);
+  schedule_hide(s);
 #endif//JBWM_USE_XOSD
 }
 uint8_t jbwm_set_vdesk(struct JBWMScreen *s,
-  struct JBWMClient *head, uint8_t v)
+  struct JBWMClient ** current_client, uint8_t v)
 {
   Display *d;
-  check_visibility(head, v);
-  s->vdesk = v;
   d=s->xlib->display;
+  if (v != s->vdesk) {
+    struct JBWMClient * c;
+    jbwm_begin_ignore_enter(d);
+    c = switch_desktop(s, v);
+    s->vdesk = v;
+    if (c)
+      jbwm_select_client(c, current_client);
+    else
+      jbwm_update_fullscreen_mode(s);
+    jbwm_end_ignore_enter(d);
+  }
   // The data (v) must be a 32 bit type.
   XChangeProperty(d, s->xlib->root, jbwm_atoms[JBWM_NET_CURRENT_DESKTOP],
     XA_CARDINAL, 8, PropModeReplace, (unsigned char *)&v, 1);
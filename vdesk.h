@@ -8,7 +8,21 @@
 #include <stdint.h>
 struct JBWMClient;
 struct JBWMScreen;
-/* Require the screen parameter here in case the head is NULL.  */
+/* Switch screen s to desktop v, touching only the clients of the
+ * outgoing and incoming desktops, and focus the client last focused
+ * there.  */
 uint8_t jbwm_set_vdesk(struct JBWMScreen *s,
-  struct JBWMClient *head, uint8_t v);
+  struct JBWMClient ** current_client, uint8_t v);
+#ifdef JBWM_USE_XOSD
+#define jbwm_get_osd_timeout() -1
+#define jbwm_hide_osd()
+#define jbwm_expose_osd(w) ((void)(w))
+#else//!JBWM_USE_XOSD
+/* Return the milliseconds left before the desktop indicator is hidden,
+ * or -1 if it is not shown.  */
+int jbwm_get_osd_timeout(void);
+void jbwm_hide_osd(void);
+// Redraw the desktop indicator if it is w, as w was uncovered.
+void jbwm_expose_osd(const Window w);
+#endif//JBWM_USE_XOSD
 #endif//!JBWM_VDESK_H
@@ -0,0 +1,33 @@
+// Copyright 2020, Alisa Bedard
+#include "wake.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+static int wake_pipe[2] = {-1, -1};
+void jbwm_set_up_wake(void)
+{
+  if (pipe(wake_pipe))
+    return;
+  fcntl(wake_pipe[0], F_SETFD, FD_CLOEXEC);
+  fcntl(wake_pipe[1], F_SETFD, FD_CLOEXEC);
+  // Neither end may block: a full pipe is woken already.
+  fcntl(wake_pipe[0], F_SETFL, O_NONBLOCK);
+  fcntl(wake_pipe[1], F_SETFL, O_NONBLOCK);
+}
+void jbwm_wake(void)
+{
+  const int saved = errno;
+  // Only a full pipe fails here, and it wakes the loop already.
+  if (write(wake_pipe[1], "", 1) < 0)
+    errno = saved;
+}
+int jbwm_get_wake_fd(void)
+{
+  return wake_pipe[0];
+}
+void jbwm_clear_wake(void)
+{
+  char b[64];
+  while (read(wake_pipe[0], b, sizeof(b)) > 0)
+    ;
+}
@@ -0,0 +1,13 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_WAKE_H
+#define JBWM_WAKE_H
+/* A pipe which wakes the event loop from a signal handler, so a signal
+ * arriving just before the loop waits is not missed.  */
+void jbwm_set_up_wake(void);
+// Async-signal-safe.
+void jbwm_wake(void);
+// Return the descriptor readable once woken, or -1.
+int jbwm_get_wake_fd(void) __attribute__((pure));
+// Consume the wake-ups, before checking what they were for.
+void jbwm_clear_wake(void);
+#endif//!JBWM_WAKE_H
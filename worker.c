@@ -0,0 +1,134 @@
+// Copyright 2020, Alisa Bedard
+#include "worker.h"
+#include "log.h"
+#include "util.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+enum { WORKER_QUEUE_SIZE = 256 }; // a power of two
+/* Each ring has one producer and one consumer.  The producer alone
+ * advances tail, and the consumer alone advances head, so neither
+ * waits.  */
+struct Ring {
+  struct JBWMProperty slot[WORKER_QUEUE_SIZE];
+  unsigned int head, tail;
+};
+static struct Ring jobs, results;
+// A byte written to a pipe follows each push, to wake the other side.
+static int job_pipe[2] = {-1, -1}, result_pipe[2] = {-1, -1};
+static Display * worker_display;
+static char * display_name;
+/* Requests taken but not returned.  Bounded by the ring size, so the
+ * worker can always push its result.  Used by the event loop only.  */
+static unsigned int in_flight;
+static bool push(struct Ring * r, const struct JBWMProperty * p)
+{
+  const unsigned int t = r->tail;
+  if (t - __atomic_load_n(&r->head, __ATOMIC_ACQUIRE) == WORKER_QUEUE_SIZE)
+    return false;
+  r->slot[t & (WORKER_QUEUE_SIZE - 1)] = *p;
+  __atomic_store_n(&r->tail, t + 1, __ATOMIC_RELEASE);
+  return true;
+}
+static bool pop(struct Ring * r, struct JBWMProperty * p)
+{
+  const unsigned int h = r->head;
+  if (h == __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE))
+    return false;
+  *p = r->slot[h & (WORKER_QUEUE_SIZE - 1)];
+  __atomic_store_n(&r->head, h + 1, __ATOMIC_RELEASE);
+  return true;
+}
+static void drain(const int fd)
+{
+  char b[64];
+  while (read(fd, b, sizeof(b)) > 0)
+    ;
+}
+static void * work(void * arg __attribute__((unused)))
+{
+  Display * d = XOpenDisplay(display_name);
+  char b[64];
+  ssize_t n;
+  if (!d)
+    return NULL; // Requests stay with the event loop.
+  fcntl(ConnectionNumber(d), F_SETFD, FD_CLOEXEC);
+  __atomic_store_n(&worker_display, d, __ATOMIC_RELEASE);
+  while ((n = read(job_pipe[0], b, sizeof(b))) > 0
+    || (n < 0 && errno == EINTR)) {
+    struct JBWMProperty p;
+    while (pop(&jobs, &p)) {
+      p.value = jbwm_get_property(d, p.window, p.atom, &p.count);
+      push(&results, &p);
+      if (write(result_pipe[1], "", 1) < 0 && errno != EAGAIN)
+        return NULL;
+    }
+  }
+  return NULL;
+}
+void jbwm_set_up_worker(Display * d)
+{
+  pthread_t t;
+  sigset_t all, old;
+  if (pipe(job_pipe))
+    return;
+  if (pipe(result_pipe)) {
+    close(job_pipe[0]);
+    close(job_pipe[1]);
+    return;
+  }
+  fcntl(job_pipe[0], F_SETFD, FD_CLOEXEC);
+  fcntl(job_pipe[1], F_SETFD, FD_CLOEXEC);
+  fcntl(result_pipe[0], F_SETFD, FD_CLOEXEC);
+  fcntl(result_pipe[1], F_SETFD, FD_CLOEXEC);
+  fcntl(job_pipe[1], F_SETFL, O_NONBLOCK);
+  fcntl(result_pipe[0], F_SETFL, O_NONBLOCK);
+  fcntl(result_pipe[1], F_SETFL, O_NONBLOCK);
+  // The worker connects by itself, so startup does not wait for it.
+  display_name = strdup(DisplayString(d));
+  // Leave signals to the event loop's thread.
+  sigfillset(&all);
+  pthread_sigmask(SIG_SETMASK, &all, &old);
+  if (!pthread_create(&t, NULL, work, NULL))
+    pthread_detach(t);
+  pthread_sigmask(SIG_SETMASK, &old, NULL);
+}
+bool jbwm_is_worker_display(Display * d)
+{
+  return d == __atomic_load_n(&worker_display, __ATOMIC_ACQUIRE);
+}
+int jbwm_get_worker_fd(void)
+{
+  return result_pipe[0];
+}
+bool jbwm_post_property(const Window w, const Atom property)
+{
+  if (!__atomic_load_n(&worker_display, __ATOMIC_ACQUIRE)
+    || in_flight == WORKER_QUEUE_SIZE
+    || !push(&jobs, &(struct JBWMProperty){.window = w, .atom = property}))
+    return false;
+  ++in_flight;
+  // A full pipe already holds a wake-up for the worker.
+  if (write(job_pipe[1], "", 1) < 0 && errno != EAGAIN) {
+    JBWM_LOG("Cannot wake the worker");
+  }
+  return true;
+}
+bool jbwm_take_property(struct JBWMProperty * p)
+{
+  if (!in_flight)
+    return false;
+  if (!pop(&results, p)) {
+    /* Clear the wake-ups, then look again, so a result pushed in between
+     * is either seen now or followed by a fresh wake-up.  */
+    drain(result_pipe[0]);
+    if (!pop(&results, p))
+      return false;
+  }
+  --in_flight;
+  return true;
+}
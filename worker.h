@@ -0,0 +1,18 @@
+// Copyright 2020, Alisa Bedard
+#ifndef JBWM_WORKER_H
+#define JBWM_WORKER_H
+#include "JBWMProperty.h"
+#include <stdbool.h>
+/* Start a thread with a connection of its own to read window properties,
+ * so that a large or slow property does not hold up input.  */
+void jbwm_set_up_worker(Display * d) __attribute__((nonnull));
+// Whether d is the worker's connection.
+bool jbwm_is_worker_display(Display * d);
+// Return a descriptor readable when properties wait, or -1.
+int jbwm_get_worker_fd(void) __attribute__((pure));
+/* Ask the worker to read property of w.  Return false if it cannot take
+ * the request now, in which case the caller should read it itself.  */
+bool jbwm_post_property(const Window w, const Atom property);
+// Take the next property read, returning false if there is none yet.
+bool jbwm_take_property(struct JBWMProperty * p) __attribute__((nonnull));
+#endif//!JBWM_WORKER_H
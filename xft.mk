@@ -1,3 +1,3 @@
 jbwm_cflags+=-DJBWM_USE_XFT
 jbwm_cflags+=`pkg-config --cflags xft`
-jbwm_ldflags+=`pkg-config --libs xft`
+jbwm_ldflags+=`pkg-config --libs xft fontconfig`
@@ -0,0 +1,4 @@
+# Copyright 2020, Alisa Bedard
+# RandR monitor support
+jbwm_cflags+=-DJBWM_USE_XRANDR
+jbwm_ldflags+=-lXrandr